@@ -0,0 +1,952 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <cstring>
+#include <string>
+
+#include "../include/hqsort/hqsort.hpp"
+#include "../include/hqsort/int_reader.hpp"
+#include "../include/hqsort/binary_dataset.hpp"
+#include "generators.hpp"
+#include "perfCounter.hpp"
+#include "statistics.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * A sort under test: sorts the whole vector in place.
+ */
+using SortFunction = void (*)(vector<int>&);
+
+/**
+ * Classical quicksort: the last element as pivot, Lomuto partition and
+ * plain recursion, as in FINAL/classicalQuicksort.cpp.
+ *
+ * @param arr The vector of integers to be sorted.
+ * @param low The starting index of the subarray to be sorted.
+ * @param high The ending index of the subarray to be sorted.
+ */
+void classicalQuickSort(vector<int>& arr, int low, int high) {
+    // Base case: if the subarray has less than 2 elements, return early.
+    if (low < high) {
+        // Choose the last element as the pivot.
+        int pivot = arr[high];
+        int i = low - 1;
+
+        // Partition the array into two subarrays.
+        for (int j = low; j < high; j++) {
+            if (arr[j] < pivot) {
+                i++;
+                swap(arr[i], arr[j]);
+                hqsort::countOperations(&hqsort::OperationCounts::swaps);
+            }
+        }
+        swap(arr[i + 1], arr[high]);
+        int pi = i + 1;
+
+        // Count the partition like the library's, in builds that count
+        hqsort::PartitionLevelScope level;
+        hqsort::countOperations(&hqsort::OperationCounts::partitionComparisons, high - low);
+        hqsort::countOperations(&hqsort::OperationCounts::swaps);
+        hqsort::countPartition(high - low + 1, min(pi - low, high - pi));
+
+        // Recursively sort the subarrays to the left and right of the pivot.
+        classicalQuickSort(arr, low, pi - 1);
+        classicalQuickSort(arr, pi + 1, high);
+    }
+}
+
+/**
+ * Classical quicksort over the whole vector.
+ *
+ * @param data The vector to sort
+ */
+void classicalQuickSort(vector<int>& data) {
+    classicalQuickSort(data, 0, static_cast<int>(data.size()) - 1);
+}
+
+/**
+ * Hossain's Quicksort: manualSort leaves, no insertion sort.
+ *
+ * @param data The vector to sort
+ */
+void hossainQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::HossainPolicy<>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the Hoare partition.
+ *
+ * @param data The vector to sort
+ */
+void proposed10QuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::Proposed10>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 50 Quicksort.
+ *
+ * @param data The vector to sort
+ */
+void proposed50QuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::Proposed50>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 100 Quicksort.
+ *
+ * @param data The vector to sort
+ */
+void proposed100QuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::Proposed100>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the branchless block partition.
+ *
+ * @param data The vector to sort
+ */
+void blockQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::BlockPartition>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the AVX2/AVX-512 partition.
+ *
+ * @param data The vector to sort
+ */
+void simdQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::SimdPartition>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the dual-pivot partition.
+ *
+ * @param data The vector to sort
+ */
+void dualPivotQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::DualPivotPartition>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed Quicksort with sorting-network leaves up to 64 elements.
+ *
+ * @param data The vector to sort
+ */
+void networkQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::NetworkPolicy<64>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the three-way partition.
+ *
+ * @param data The vector to sort
+ */
+void threeWayQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::ThreeWayPartition>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the natural run pre-pass.
+ *
+ * @param data The vector to sort
+ */
+void adaptiveQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::AdaptivePolicy<hqsort::Proposed10>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the radix sort path for large ranges.
+ *
+ * @param data The vector to sort
+ */
+void radixQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::RadixPolicy<hqsort::Proposed10>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the counting sort path for dense key ranges.
+ *
+ * @param data The vector to sort
+ */
+void countingQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::CountingPolicy<hqsort::Proposed10>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the introsort depth limit.
+ *
+ * @param data The vector to sort
+ */
+void guardedQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::DepthLimitedPolicy<hqsort::Proposed10>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the median-of-3 pivot.
+ *
+ * @param data The vector to sort
+ */
+void medianOfThreeQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::MedianOfThreePivot>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with Tukey's ninther pivot.
+ *
+ * @param data The vector to sort
+ */
+void nintherQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::NintherPivot>>(data.begin(), data.end());
+}
+
+/**
+ * Proposed 10 Quicksort with the median of 9 sampled keys as pivot.
+ *
+ * @param data The vector to sort
+ */
+void sampledQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::SampledPivot<9>>>(data.begin(), data.end());
+}
+
+/**
+ * A sort variant the driver can run, by its command-line name.
+ */
+struct Variant {
+    const char* name;
+    SortFunction sortData;
+};
+
+/**
+ * Every registered variant. The first five are the sorts of the paper.
+ */
+const vector<Variant> variants = {
+    {"classical", classicalQuickSort},
+    {"hossain", hossainQuickSort},
+    {"proposed10", proposed10QuickSort},
+    {"proposed50", proposed50QuickSort},
+    {"proposed100", proposed100QuickSort},
+    {"block", blockQuickSort},
+    {"simd", simdQuickSort},
+    {"threeway", threeWayQuickSort},
+    {"dualpivot", dualPivotQuickSort},
+    {"network", networkQuickSort},
+    {"adaptive", adaptiveQuickSort},
+    {"radix", radixQuickSort},
+    {"counting", countingQuickSort},
+    {"guarded", guardedQuickSort},
+    {"median3", medianOfThreeQuickSort},
+    {"ninther", nintherQuickSort},
+    {"sample", sampledQuickSort}
+};
+const size_t paperVariantCount = 5;
+
+/**
+ * Totals over the partitions made by RecordingPartition.
+ */
+struct PartitionBalance {
+    static inline double leftFraction = 0;    // Sum of |left| / n
+    static inline double smallerFraction = 0; // Sum of min(|left|, |right|) / n
+    static inline long long partitions = 0;
+};
+
+/**
+ * Hoare partition that adds the balance of every split to PartitionBalance.
+ */
+struct RecordingPartition {
+    template <class RandomIt, class Key, class Keys>
+    static RandomIt partition(RandomIt first, RandomIt last, const Key& pivot, const Keys& keys) {
+        RandomIt split = hqsort::partition(first, last, pivot, keys);
+        double size = static_cast<double>(last - first);
+        PartitionBalance::leftFraction += (split - first) / size;
+        PartitionBalance::smallerFraction += min(split - first, last - split) / size;
+        ++PartitionBalance::partitions;
+        return split;
+    }
+};
+
+/**
+ * Proposed 10 Quicksort with the given pivot rule, recording the balance
+ * of its partitions.
+ *
+ * @param data The vector to sort
+ */
+template <class PivotRule>
+void recordingQuickSort(vector<int>& data) {
+    hqsort::sort<hqsort::ProposedPolicy<10, PivotRule, RecordingPartition>>(data.begin(), data.end());
+}
+
+/**
+ * Sorts every dataset once with each pivot rule and reports the mean
+ * balance of their partitions as |left|/n and min(|left|, |right|)/n; 0.5
+ * is a perfect split for both.
+ *
+ * @param file The output file to write the results to
+ * @param seed The seed of the datasets
+ * @param cacheDirectory The dataset cache, or "" for none
+ */
+void runBalance(ofstream& file, uint64_t seed, const string& cacheDirectory) {
+    vector<size_t> sizes = {1000, 10000, 100000};
+    vector<string> pivotNames = {"minmax", "mean", "median3", "ninther", "sample9"};
+    vector<SortFunction> pivotSorts = {
+        recordingQuickSort<hqsort::MinMaxProbePivot>, recordingQuickSort<hqsort::MeanOfHalvesPivot>,
+        recordingQuickSort<hqsort::MedianOfThreePivot>, recordingQuickSort<hqsort::NintherPivot>,
+        recordingQuickSort<hqsort::SampledPivot<9>>
+    };
+
+    for (size_t size : sizes) {
+        ostringstream table;
+        table << "Data Size: " << size << " (mean |left|/n / mean smaller/n)" << endl;
+        table << setw(15) << left << "Dataset" << right;
+        for (const string& pivotName : pivotNames) {
+            table << setw(16) << pivotName;
+        }
+        table << endl;
+
+        for (const Distribution& distribution : catalogue) {
+            vector<int> dataset = loadDataset(distribution, size, seed, 0, cacheDirectory);
+            table << setw(15) << left << distribution.name << right;
+            for (SortFunction pivotSort : pivotSorts) {
+                PartitionBalance::leftFraction = 0;
+                PartitionBalance::smallerFraction = 0;
+                PartitionBalance::partitions = 0;
+
+                vector<int> data = dataset;
+                pivotSort(data);
+
+                double partitions = static_cast<double>(max(PartitionBalance::partitions, 1LL));
+                ostringstream cell;
+                cell << fixed << setprecision(3) << PartitionBalance::leftFraction / partitions << "/"
+                     << PartitionBalance::smallerFraction / partitions;
+                table << setw(16) << cell.str();
+            }
+            table << endl;
+        }
+        table << "---------------------------------" << endl;
+
+        cout << table.str();
+        file << table.str();
+    }
+}
+
+/**
+ * Sorts every dataset once with each variant and reports what the sort
+ * did: its comparisons, also relative to n log2 n, swaps, other element
+ * moves, manualSort and insertionSort calls, partitions, the mean smaller
+ * side of a partition over the range size, and the deepest nesting of
+ * partitions against log2 n. Quadratic behaviour shows as comparisons
+ * per n log2 n and depths that grow with n.
+ *
+ * The counts exist only in builds with HQSORT_COUNT_OPERATIONS set to 1;
+ * other builds say so instead. Variants outside the Hoare partition and
+ * insertion sort leaves count only partitions and depth, see
+ * hqsort::OperationCounts.
+ *
+ * @param file The output file to write the results to
+ * @param selected The variants to count
+ * @param distributions The distributions to generate datasets from
+ * @param seed The seed of the datasets
+ * @param cacheDirectory The dataset cache, or "" for none
+ */
+void runOperationCounts(ofstream& file, const vector<Variant>& selected, const vector<Distribution>& distributions,
+                        uint64_t seed, const string& cacheDirectory) {
+    if (!hqsort::countsOperations) {
+        ostringstream note;
+        note << "Operation counts need a build with -DHQSORT_COUNT_OPERATIONS=1" << endl;
+        cout << note.str();
+        file << note.str();
+        return;
+    }
+
+    vector<size_t> sizes = {1000, 10000, 100000};
+    for (size_t size : sizes) {
+        double log2Size = log2(static_cast<double>(size));
+        ostringstream table;
+        table << "Data Size: " << size << " (operations per sort; log2 n = " << fixed << setprecision(2) << log2Size
+              << ")" << endl;
+        table << setw(15) << left << "Dataset" << setw(13) << "Variant" << right << setw(13) << "Partition cmp"
+              << setw(13) << "Leaf cmp" << setw(11) << "/n log2 n" << setw(12) << "Swaps" << setw(12) << "Moves"
+              << setw(12) << "manualSort" << setw(10) << "Insertion" << setw(11) << "Partitions" << setw(10)
+              << "Smaller/n" << setw(10) << "Depth" << endl;
+
+        for (const Distribution& distribution : distributions) {
+            vector<int> dataset = loadDataset(distribution, size, seed, 0, cacheDirectory);
+            for (const Variant& variant : selected) {
+                vector<int> data = dataset;
+                hqsort::resetOperationCounts();
+                variant.sortData(data);
+                hqsort::OperationCounts counts = hqsort::operationCounts();
+
+                double comparisons = static_cast<double>(counts.partitionComparisons + counts.leafComparisons);
+                double partitions = static_cast<double>(max<uint64_t>(counts.partitions, 1));
+                table << setw(15) << left << distribution.name << setw(13) << variant.name << right << setw(13)
+                      << counts.partitionComparisons << setw(13) << counts.leafComparisons << setw(11)
+                      << setprecision(2) << comparisons / (static_cast<double>(size) * log2Size) << setw(12)
+                      << counts.swaps << setw(12) << counts.moves << setw(12) << counts.manualSortCalls << setw(10)
+                      << counts.insertionSortCalls << setw(11) << counts.partitions << setw(10) << setprecision(3)
+                      << counts.smallerSideSum / partitions << setw(10) << counts.maxDepth;
+                if (!is_sorted(data.begin(), data.end())) {
+                    table << " !";
+                }
+                table << endl;
+            }
+        }
+        table << "---------------------------------" << endl;
+
+        cout << table.str();
+        file << table.str();
+    }
+}
+
+/**
+ * Settings of runComparison.
+ *
+ * Every variant first sorts warmups copies of each dataset untimed, which
+ * also measures how long one sort takes. Sorts shorter than minBatchNanos
+ * are timed in batches of copies between two clock reads, so each sample
+ * is long against the clock's resolution; batches hold at most
+ * maxBatchElements elements. Without warmups every sample is one sort.
+ * Every input is timed repeats times, or once where a variant takes longer
+ * than longSortNanos, as the classical quicksort does on Reversed data.
+ * counters enables the hardware counters around every sample.
+ */
+struct TimingOptions {
+    int iterations = 10;
+    int repeats = 3;
+    int warmups = 1;
+    double minBatchNanos = 20000;
+    size_t maxBatchElements = size_t(1) << 18;
+    double longSortNanos = 1e8;
+    bool counters = true;
+};
+
+/**
+ * Times one sample: sorts a batch of copies of a dataset, made before the
+ * clock starts into vectors that are reused, and returns the nanoseconds
+ * and hardware events per sort. The counters run around the clock reads,
+ * so they see the same sorts and nothing else of the benchmark.
+ *
+ * @param sortData The sort to time
+ * @param dataset The input
+ * @param copies The reused copies; their number is the batch size
+ * @param counters The counters to read, possibly none or unavailable
+ * @param events Receives the count of every event per sort, negative
+ *               where unavailable
+ * @return The nanoseconds per sort
+ */
+double timeBatch(SortFunction sortData, const vector<int>& dataset, vector<vector<int>>& copies,
+                 PerfCounterSet& counters, vector<double>& events) {
+    for (vector<int>& copy : copies) {
+        copy.assign(dataset.begin(), dataset.end());
+    }
+
+    vector<long long> counts;
+    counters.start();
+    auto startSorting = high_resolution_clock::now();
+    for (vector<int>& copy : copies) {
+        sortData(copy);
+    }
+    auto stopSorting = high_resolution_clock::now();
+    counters.stop(counts);
+
+    double batch = static_cast<double>(copies.size());
+    events.resize(counts.size());
+    for (size_t e = 0; e < counts.size(); ++e) {
+        events[e] = counts[e] < 0 ? -1 : counts[e] / batch;
+    }
+    return duration<double, nano>(stopSorting - startSorting).count() / batch;
+}
+
+/**
+ * Runs every selected variant on identical inputs: the datasets of every
+ * iteration are drawn from the seed, or taken from the cache, before any
+ * timing starts, and every variant sorts its own copies of them.
+ *
+ * For each size it prints the median time per sort side by side
+ * with the rank of every variant on every dataset (1 is the fastest),
+ * then the 5th to 95th percentile of the samples and the 95% bootstrap
+ * interval of the median. A variant marked ~ is not significantly slower
+ * than the fastest on that dataset (paired bootstrap test on the samples
+ * of the same inputs); such rankings should not decide anything. Where
+ * hardware counters are available the mean cycles, instructions, branch
+ * misses, L1 data, last level cache and dTLB misses per sort follow, with
+ * the instructions per cycle, to show why one variant is faster; a summary
+ * of first places and mean ranks over all datasets ends the report.
+ *
+ * @param file The output file to write the results to
+ * @param selected The variants to compare
+ * @param distributions The distributions to generate datasets from
+ * @param timing The iterations, repeats, warmups, batching and counters
+ * @param seed The seed of the datasets
+ * @param cacheDirectory The dataset cache, or "" for none
+ */
+void runComparison(ofstream& file, const vector<Variant>& selected, const vector<Distribution>& distributions,
+                   const TimingOptions& timing, uint64_t seed, const string& cacheDirectory) {
+    // Define the sizes to test
+    vector<size_t> sizes = {10, 100, 1000, 10000, 100000};
+
+    // Totals for the summary; runtimes are compared with hossain's if it
+    // runs, by the geometric mean of the ratios so one quadratic case does
+    // not swamp the rest
+    vector<int> firstPlaces(selected.size(), 0);
+    vector<int> tiedFirstPlaces(selected.size(), 0);
+    vector<double> rankSums(selected.size(), 0);
+    vector<double> logRatioSums(selected.size(), 0);
+    bool anyUnsorted = false;
+    size_t hossain = selected.size();
+    if (hqsort::countsOperations) {
+        ostringstream note;
+        note << "Built with HQSORT_COUNT_OPERATIONS: the times include the counting" << endl;
+        cout << note.str();
+        file << note.str();
+    }
+
+    // Open the counters once; in containers and under a strict
+    // perf_event_paranoid they fail to open and the tables are left out
+    PerfCounterSet counters(timing.counters ? allPerfEvents : vector<PerfEvent>());
+    size_t eventCount = counters.events().size();
+    auto eventIndex = [&](PerfEvent event) {
+        return static_cast<size_t>(find(counters.events().begin(), counters.events().end(), event) -
+                                   counters.events().begin());
+    };
+    size_t cycles = eventIndex(PerfEvent::Cycles);
+    size_t instructions = eventIndex(PerfEvent::Instructions);
+    if (timing.counters && !counters.anyAvailable()) {
+        ostringstream note;
+        note << "Hardware counters unavailable (" << strerror(counters.error()) << ")" << endl;
+        cout << note.str();
+        file << note.str();
+    }
+    vector<double> events;
+    for (size_t v = 0; v < selected.size(); ++v) {
+        if (string(selected[v].name) == "hossain") {
+            hossain = v;
+        }
+    }
+
+    for (size_t size : sizes) {
+        vector<vector<vector<double>>> samples(distributions.size(), vector<vector<double>>(selected.size()));
+        // Sums and numbers of the counted samples of every event
+        vector<vector<vector<double>>> eventTotals(distributions.size(),
+                                                   vector<vector<double>>(selected.size(), vector<double>(eventCount, 0)));
+        vector<vector<vector<int>>> eventSamples(distributions.size(),
+                                                 vector<vector<int>>(selected.size(), vector<int>(eventCount, 0)));
+        vector<vector<size_t>> batches(distributions.size(), vector<size_t>(selected.size(), 1));
+        vector<vector<bool>> unsorted(distributions.size(), vector<bool>(selected.size(), false));
+        vector<int> repeats(distributions.size(), timing.repeats);
+        vector<vector<int>> copies;
+
+        // Prepare the inputs of every iteration up front, so generating
+        // them stays out of the timed loop; distributions that are not
+        // random, the slow killer sequence among them, have one dataset
+        vector<vector<vector<int>>> inputs(distributions.size());
+        for (size_t d = 0; d < distributions.size(); ++d) {
+            int count = distributions[d].random ? timing.iterations : 1;
+            for (int i = 0; i < count; ++i) {
+                inputs[d].push_back(loadDataset(distributions[d], size, seed, i, cacheDirectory));
+            }
+        }
+
+        // Warm up every variant on every distribution and size its batches
+        // from the time of one sort
+        size_t maxBatch = max<size_t>(timing.maxBatchElements / max<size_t>(size, 1), 1);
+        for (size_t d = 0; d < distributions.size() && timing.warmups > 0; ++d) {
+            for (size_t v = 0; v < selected.size(); ++v) {
+                copies.resize(1);
+                double nanos = 0;
+                for (int w = 0; w < timing.warmups; ++w) {
+                    nanos = timeBatch(selected[v].sortData, inputs[d][0], copies, counters, events);
+                }
+                if (nanos < timing.minBatchNanos) {
+                    batches[d][v] = min(static_cast<size_t>(ceil(timing.minBatchNanos / max(nanos, 1.0))), maxBatch);
+                }
+                if (nanos > timing.longSortNanos) {
+                    repeats[d] = 1;
+                }
+            }
+        }
+
+        // Take the samples, every variant on the same input in turn
+        for (int i = 0; i < timing.iterations; ++i) {
+            for (size_t d = 0; d < distributions.size(); ++d) {
+                const vector<int>& dataset = inputs[d][distributions[d].random ? i : 0];
+                for (int r = 0; r < repeats[d]; ++r) {
+                    for (size_t v = 0; v < selected.size(); ++v) {
+                        copies.resize(batches[d][v]);
+                        double nanos = timeBatch(selected[v].sortData, dataset, copies, counters, events);
+                        samples[d][v].push_back(nanos);
+                        if (nanos > timing.longSortNanos) {
+                            repeats[d] = 1;
+                        }
+
+                        // Check the output outside the timed region
+                        if (!is_sorted(copies[0].begin(), copies[0].end())) {
+                            unsorted[d][v] = true;
+                            anyUnsorted = true;
+                        }
+                        for (size_t e = 0; e < eventCount; ++e) {
+                            if (events[e] >= 0) {
+                                eventTotals[d][v][e] += events[e];
+                                ++eventSamples[d][v][e];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        copies.clear();
+
+        // Rank the medians and test every variant against the fastest;
+        // times are shown in a unit that suits the size
+        size_t sampleCount = static_cast<size_t>(timing.iterations) * timing.repeats;
+        const char* unit = size <= 100 ? "nanoseconds" : size <= 10000 ? "microseconds" : "milliseconds";
+        double scale = size <= 100 ? 1 : size <= 10000 ? 1e3 : 1e6;
+        ostringstream table;
+        ostringstream spread;
+        ostringstream interval;
+        table << "Data Size: " << size << " (median " << unit << " per sort over up to " << sampleCount
+              << " samples, rank; ~ not significantly slower than the fastest)" << endl;
+        table << setw(15) << left << "Dataset" << right;
+        for (const Variant& variant : selected) {
+            table << setw(18) << variant.name;
+        }
+        table << endl;
+        spread << "5th-95th percentile:" << endl;
+        interval << "95% confidence interval of the median:" << endl;
+
+        for (size_t d = 0; d < distributions.size(); ++d) {
+            vector<SampleSummary> summaries;
+            size_t fastest = 0;
+            for (size_t v = 0; v < selected.size(); ++v) {
+                summaries.push_back(summarize(samples[d][v]));
+                if (summaries[v].median < summaries[fastest].median) {
+                    fastest = v;
+                }
+            }
+
+            table << setw(15) << left << distributions[d].name << right;
+            spread << setw(15) << left << distributions[d].name << right;
+            interval << setw(15) << left << distributions[d].name << right;
+            for (size_t v = 0; v < selected.size(); ++v) {
+                int rank = 1;
+                for (size_t other = 0; other < selected.size(); ++other) {
+                    rank += summaries[other].median < summaries[v].median;
+                }
+                bool tied = v != fastest && !significantlyDifferent(samples[d][v], samples[d][fastest]);
+                firstPlaces[v] += rank == 1;
+                tiedFirstPlaces[v] += rank == 1 || tied;
+                rankSums[v] += rank;
+                if (hossain < selected.size()) {
+                    logRatioSums[v] += log(max(summaries[v].median, 1.0) / max(summaries[hossain].median, 1.0));
+                }
+
+                ostringstream cell;
+                cell << fixed << setprecision(2) << summaries[v].median / scale << " (" << rank << (tied ? "~" : "") << ")";
+                if (unsorted[d][v]) {
+                    cell << "!";
+                }
+                table << setw(18) << cell.str();
+
+                ostringstream range;
+                range << fixed << setprecision(2) << summaries[v].p5 / scale << "-" << summaries[v].p95 / scale;
+                spread << setw(18) << range.str();
+                range.str("");
+                range << summaries[v].medianLow / scale << "-" << summaries[v].medianHigh / scale;
+                interval << setw(18) << range.str();
+            }
+            table << endl;
+            spread << endl;
+            interval << endl;
+        }
+        table << spread.str() << interval.str();
+
+        // Mean counts per sort of every event that could be counted;
+        // "n/a" where the kernel never scheduled the counter
+        auto meanEvents = [&](size_t d, size_t v, size_t e) {
+            return eventSamples[d][v][e] == 0 ? -1.0 : eventTotals[d][v][e] / eventSamples[d][v][e];
+        };
+        for (size_t e = 0; e < eventCount; ++e) {
+            if (!counters.available(e)) {
+                continue;
+            }
+            table << perfEventName(counters.events()[e]) << " (mean per sort):" << endl;
+            for (size_t d = 0; d < distributions.size(); ++d) {
+                table << setw(15) << left << distributions[d].name << right;
+                for (size_t v = 0; v < selected.size(); ++v) {
+                    double mean = meanEvents(d, v, e);
+                    if (mean < 0) {
+                        table << setw(18) << "n/a";
+                    } else {
+                        table << setw(18) << fixed << setprecision(0) << mean;
+                    }
+                }
+                table << endl;
+            }
+        }
+        if (cycles < eventCount && instructions < eventCount && counters.available(cycles) &&
+            counters.available(instructions)) {
+            table << "Instructions per cycle:" << endl;
+            for (size_t d = 0; d < distributions.size(); ++d) {
+                table << setw(15) << left << distributions[d].name << right;
+                for (size_t v = 0; v < selected.size(); ++v) {
+                    double meanCycles = meanEvents(d, v, cycles);
+                    double meanInstructions = meanEvents(d, v, instructions);
+                    if (meanCycles <= 0 || meanInstructions < 0) {
+                        table << setw(18) << "n/a";
+                    } else {
+                        table << setw(18) << fixed << setprecision(2) << meanInstructions / meanCycles;
+                    }
+                }
+                table << endl;
+            }
+        }
+        table << "---------------------------------" << endl;
+
+        cout << table.str();
+        file << table.str();
+    }
+
+    // First places and mean ranks over every size and distribution
+    int datasets = static_cast<int>(sizes.size() * distributions.size());
+    ostringstream summary;
+    summary << "Summary over " << datasets << " datasets:" << endl;
+    for (size_t v = 0; v < selected.size(); ++v) {
+        summary << setw(15) << left << selected[v].name << right << "1st in " << setw(3) << firstPlaces[v]
+                << " of " << datasets << " (" << tiedFirstPlaces[v] << " counting ties), mean rank " << fixed
+                << setprecision(2) << rankSums[v] / datasets;
+        if (hossain < selected.size() && v != hossain) {
+            double ratio = exp(logRatioSums[v] / datasets);
+            summary << ", " << setprecision(2) << 100 * abs(1 - ratio) << (ratio <= 1 ? "% faster" : "% slower")
+                    << " than hossain";
+        }
+        summary << endl;
+    }
+    if (anyUnsorted) {
+        summary << "! marks datasets a variant left unsorted" << endl;
+    }
+    cout << summary.str();
+    file << summary.str();
+}
+
+/**
+ * Writes Uniform datasets to a text file, one integer per line like
+ * FINAL/DATASETS, and compares how fast formatted stream extraction and
+ * hqsort::loadIntegers read them back.
+ *
+ * @param file The output file to write the results to
+ * @param seed The seed of the datasets
+ */
+void runLoadTests(ofstream& file, uint64_t seed) {
+    const string path = "load_test_dataset.txt";
+    const string binaryPath = "load_test_dataset.bin";
+    vector<size_t> sizes = {10000, 100000, 1000000};
+
+    ostringstream table;
+    table << "Loading throughput:" << endl;
+    for (size_t size : sizes) {
+        vector<int> dataset = generateUniformData(size, datasetSeed(seed, "Uniform", size, 0));
+        {
+            ofstream text(path);
+            for (int value : dataset) {
+                text << value << '\n';
+            }
+        }
+
+        // Formatted extraction, as the FINAL programs load their datasets
+        auto startStream = high_resolution_clock::now();
+        vector<int> streamed;
+        ifstream input(path);
+        int value;
+        while (input >> value) {
+            streamed.push_back(value);
+        }
+        auto stopStream = high_resolution_clock::now();
+
+        hqsort::IntegerLoadStats stats;
+        vector<int> loaded;
+        auto startLoad = high_resolution_clock::now();
+        bool ok = hqsort::loadIntegers(path, loaded, stats);
+        auto stopLoad = high_resolution_clock::now();
+
+        // A binary dataset is mapped instead of parsed; copy it out as the
+        // benchmarks need their own vector
+        hqsort::writeBinaryDataset(binaryPath, dataset.data(), dataset.size());
+        auto startMap = high_resolution_clock::now();
+        hqsort::MappedDataset<int> mapped;
+        bool mappedOk = mapped.open(binaryPath);
+        vector<int> copied = mapped.toVector();
+        auto stopMap = high_resolution_clock::now();
+        mapped.close();
+
+        double megabytes = static_cast<double>(stats.bytes) / 1e6;
+        double streamSeconds = duration<double>(stopStream - startStream).count();
+        double loadSeconds = duration<double>(stopLoad - startLoad).count();
+        double mapMilliseconds = duration<double, milli>(stopMap - startMap).count();
+        table << "Data Size " << size << ": ifstream >> " << fixed << setprecision(1) << megabytes / streamSeconds
+              << " MB/s, loadIntegers " << megabytes / loadSeconds << " MB/s, binary map and copy "
+              << setprecision(3) << mapMilliseconds << " ms";
+        if (!ok || !mappedOk || loaded != dataset || streamed != dataset || copied != dataset) {
+            table << " (mismatch)";
+        }
+        table << endl;
+    }
+    table << "---------------------------------" << endl;
+    remove(path.c_str());
+    remove(binaryPath.c_str());
+
+    cout << table.str();
+    file << table.str();
+}
+
+/**
+ * @brief Main function that runs the benchmarks and writes the results to
+ * quick_sort_test_results.txt.
+ *
+ * Usage: benchmark [VARIANT... | all | balance | load | operations] [--iterations N]
+ *        [--repeats N] [--warmup N] [--datasets paper|all|NAME,...] [--seed N]
+ *        [--cache DIR | --no-cache] [--no-counters]
+ *
+ * Without variants it compares the sorts of the paper (classical,
+ * hossain, proposed10, proposed50 and proposed100) on the paper's five
+ * distributions, the 25 datasets of its tables. Named variants, or "all"
+ * of them, are compared on the whole catalogue unless --datasets names
+ * "paper" or a comma-separated list of distributions. "balance" reports
+ * the partition balance of every pivot rule and "load" the throughput of
+ * loading integer files instead; "operations" counts the comparisons,
+ * swaps, moves and partition depth of the selected variants in builds with
+ * HQSORT_COUNT_OPERATIONS set. --iterations sets how many inputs every
+ * random distribution draws (10 by default), --repeats how often each is
+ * timed (3 by default) and --warmup how often each variant sorts a dataset
+ * before timing starts (1 by default, 0 for none). --no-counters leaves the hardware
+ * counters closed.
+ *
+ * The datasets follow from --seed (kDefaultSeed by default), which heads
+ * the results so a run can be repeated, and are cached as binary datasets
+ * in --cache (benchmark_cache by default).
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    const string usage = string("Usage: ") + argv[0] +
+                         " [VARIANT... | all | balance | load | operations] [--iterations N] [--repeats N] [--warmup N]"
+                         " [--datasets paper|all|NAME,...] [--seed N] [--cache DIR | --no-cache] [--no-counters]";
+    vector<Variant> selected;
+    string mode;
+    string datasets;
+    TimingOptions timing;
+    uint64_t seed = kDefaultSeed;
+    string cacheDirectory = "benchmark_cache";
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--iterations" && i + 1 < argc) {
+            timing.iterations = max(atoi(argv[++i]), 1);
+        } else if (argument == "--repeats" && i + 1 < argc) {
+            timing.repeats = max(atoi(argv[++i]), 1);
+        } else if (argument == "--warmup" && i + 1 < argc) {
+            timing.warmups = atoi(argv[++i]);
+            if (timing.warmups < 0) {
+                cerr << usage << endl;
+                return 1;
+            }
+        } else if (argument == "--datasets" && i + 1 < argc) {
+            datasets = argv[++i];
+        } else if (argument == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--cache" && i + 1 < argc) {
+            cacheDirectory = argv[++i];
+        } else if (argument == "--no-cache") {
+            cacheDirectory.clear();
+        } else if (argument == "--no-counters") {
+            timing.counters = false;
+        } else if (argument == "balance" || argument == "load" || argument == "operations") {
+            mode = argument;
+        } else if (argument == "all") {
+            selected = variants;
+        } else if (argument.compare(0, 2, "--") == 0) {
+            cerr << usage << endl;
+            return 1;
+        } else {
+            auto variant = find_if(variants.begin(), variants.end(),
+                                   [&](const Variant& candidate) { return argument == candidate.name; });
+            if (variant == variants.end()) {
+                cerr << "Unknown variant: " << argument << " (expected";
+                for (const Variant& candidate : variants) {
+                    cerr << " " << candidate.name;
+                }
+                cerr << ", all, balance, load or operations)" << endl;
+                return 1;
+            }
+            selected.push_back(*variant);
+        }
+    }
+
+    // The paper's comparison by default
+    if (datasets.empty()) {
+        datasets = selected.empty() ? "paper" : "all";
+    }
+    if (selected.empty()) {
+        selected.assign(variants.begin(), variants.begin() + paperVariantCount);
+    }
+
+    // Pick the distributions from the catalogue
+    vector<Distribution> distributions;
+    if (datasets == "paper") {
+        distributions = paperDistributions;
+    } else if (datasets == "all") {
+        distributions = catalogue;
+    } else {
+        istringstream names(datasets);
+        string name;
+        while (getline(names, name, ',')) {
+            const Distribution* distribution = findDistribution(name);
+            if (distribution == nullptr) {
+                cerr << "Unknown distribution: " << name << " (expected";
+                for (const Distribution& candidate : catalogue) {
+                    cerr << " " << distributionKey(candidate.name);
+                }
+                cerr << ", paper or all)" << endl;
+                return 1;
+            }
+            distributions.push_back(*distribution);
+        }
+    }
+
+    // Open the output file for writing
+    ofstream file("quick_sort_test_results.txt");
+
+    // Check if the file was successfully opened
+    if (file.is_open()) {
+        // Record the seed so the run can be repeated
+        file << "Seed: " << seed << endl;
+        cout << "Seed: " << seed << endl;
+
+        // Run the tests and write the results to the file
+        if (mode == "balance") {
+            runBalance(file, seed, cacheDirectory);
+        } else if (mode == "load") {
+            runLoadTests(file, seed);
+        } else if (mode == "operations") {
+            runOperationCounts(file, selected, distributions, seed, cacheDirectory);
+        } else {
+            runComparison(file, selected, distributions, timing, seed, cacheDirectory);
+        }
+
+        // Close the file
+        file.close();
+    } else {
+        // Print an error message if the file could not be opened
+        cerr << "Unable to open file for writing." << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <iostream>
+#include <string>
+
+#include "../include/hqsort/binary_dataset.hpp"
+
+using namespace std;
+
+/**
+ * @brief Converts text datasets of newline-separated integers, such as
+ * the .txt files in FINAL/DATASETS, into binary datasets that hqsort::MappedDataset
+ * maps in place.
+ *
+ * Usage: convertDataset INPUT.txt...
+ *
+ * Each INPUT.txt is written to INPUT.bin next to it. Lines that are not
+ * integers are left out and reported.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " INPUT.txt..." << endl;
+        return 1;
+    }
+
+    int status = 0;
+    for (int i = 1; i < argc; ++i) {
+        string textPath = argv[i];
+        string::size_type dot = textPath.find_last_of('.');
+        string::size_type slash = textPath.find_last_of('/');
+        string binaryPath = (dot != string::npos && (slash == string::npos || dot > slash) ? textPath.substr(0, dot) : textPath) + ".bin";
+
+        hqsort::IntegerLoadStats stats;
+        if (!hqsort::convertTextDataset(textPath, binaryPath, stats)) {
+            cerr << "Error converting " << textPath << " to " << binaryPath << endl;
+            status = 1;
+            continue;
+        }
+        for (const hqsort::ParseError& error : stats.errors) {
+            cerr << textPath << ":" << error.line << ": not an integer: " << error.text << endl;
+        }
+        if (stats.malformedLines > stats.errors.size()) {
+            cerr << textPath << ": " << stats.malformedLines - stats.errors.size() << " more malformed lines" << endl;
+        }
+
+        hqsort::MappedDataset<int> dataset;
+        if (!dataset.open(binaryPath, true)) {
+            cerr << dataset.error() << endl;
+            status = 1;
+            continue;
+        }
+        cout << textPath << " -> " << binaryPath << ": " << dataset.size() << " integers" << endl;
+    }
+    return status;
+}
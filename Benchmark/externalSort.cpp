@@ -0,0 +1,69 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+
+#include "../include/hqsort/external_sort.hpp"
+
+using namespace std;
+
+/**
+ * @brief Sorts a file of newline-separated integers that may be larger than
+ * memory and reports the throughput.
+ *
+ * Usage: externalSort INPUT OUTPUT [--memory MB] [--fan-in N] [--temp DIR]
+ *
+ * Chunks of at most --memory megabytes of integers (256 by default) are
+ * sorted with the proposed quicksort and spilled to DIR, then merged, at
+ * most --fan-in runs (128 by default) at a time. Lines that are not
+ * integers are skipped and reported.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Usage: " << argv[0] << " INPUT OUTPUT [--memory MB] [--fan-in N] [--temp DIR]" << endl;
+        return 1;
+    }
+    string inputPath = argv[1];
+    string outputPath = argv[2];
+
+    hqsort::ExternalSortOptions options;
+    for (int i = 3; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--memory" && i + 1 < argc) {
+            options.memoryBudget = strtoull(argv[++i], nullptr, 10) << 20;
+        } else if (argument == "--fan-in" && i + 1 < argc) {
+            options.fanIn = strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--temp" && i + 1 < argc) {
+            options.tempDirectory = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " INPUT OUTPUT [--memory MB] [--fan-in N] [--temp DIR]" << endl;
+            return 1;
+        }
+    }
+    if (options.memoryBudget == 0) {
+        cerr << "The memory budget must be at least 1 MB" << endl;
+        return 1;
+    }
+
+    hqsort::ExternalSortStats stats;
+    if (!hqsort::externalSort<hqsort::Proposed10>(inputPath, outputPath, options, stats)) {
+        cerr << "Error sorting " << inputPath << " into " << outputPath << endl;
+        return 1;
+    }
+
+    for (const hqsort::ParseError& error : stats.errors) {
+        cerr << inputPath << ":" << error.line << ": not an integer: " << error.text << endl;
+    }
+    if (stats.malformedLines > stats.errors.size()) {
+        cerr << inputPath << ": " << stats.malformedLines - stats.errors.size() << " more malformed lines" << endl;
+    }
+
+    double megabytes = static_cast<double>(stats.inputBytes) / 1e6;
+    cout << "Sorted " << stats.elements << " integers in " << stats.runs << " runs and "
+         << stats.mergePasses << " merge passes" << endl;
+    cout << fixed << setprecision(3) << "Time: " << stats.seconds << " s, "
+         << setprecision(1) << megabytes / stats.seconds << " MB/s" << endl;
+    return 0;
+}
@@ -0,0 +1,567 @@
+#ifndef BENCHMARK_GENERATORS_HPP
+#define BENCHMARK_GENERATORS_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../include/hqsort/binary_dataset.hpp"
+#include "../include/hqsort/keys.hpp"
+#include "../include/hqsort/partition.hpp"
+#include "../include/hqsort/pivot.hpp"
+
+/**
+ * The seed the benchmarks use unless --seed gives another.
+ */
+constexpr std::uint64_t kDefaultSeed = 1;
+
+/**
+ * Creates a mersenne twister generator from all 64 bits of a seed.
+ *
+ * The same seed gives the same numbers on every host, but the standard
+ * library's distributions may turn them into different values on another
+ * toolchain; the binary dataset cache of loadDataset keeps the datasets
+ * themselves.
+ *
+ * @param seed The seed
+ * @return The generator
+ */
+inline std::mt19937 seededGenerator(std::uint64_t seed) {
+    std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+    return std::mt19937(sequence);
+}
+
+/**
+ * Generates a vector of size integers with a uniform distribution.
+ * The distribution is centered at size / 2 and has a range of size.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of size integers with a uniform distribution
+ */
+inline std::vector<int> generateUniformData(std::size_t size, std::uint64_t seed) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+    
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+    
+    // Create a uniform integer distribution with a range of 0 to size - 1
+    std::uniform_int_distribution<> dis(0, size - 1);
+    
+    // Generate random integers and store them in the data vector
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = dis(gen);
+    }
+    
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers with a bimodal distribution.
+ * The distribution consists of two normal distributions centered
+ * at size/3 and 2*size/3, respectively. The range of the distribution
+ * is from 0 to size-1.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of size integers with a bimodal distribution
+ */
+inline std::vector<int> generateBimodalData(std::size_t size, std::uint64_t seed) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+    
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+    
+    // Create two normal distributions with ranges from 0 to size-1
+    std::normal_distribution<> dis1(size / 3, size / 20);
+    std::normal_distribution<> dis2(2 * size / 3, size / 20);
+    
+    // Generate random integers and store them in the data vector
+    for (std::size_t i = 0; i < size; ++i) {
+        // Alternate between the two normal distributions
+        if (i % 2 == 0) {
+            data[i] = std::round(dis1(gen));
+        } else {
+            data[i] = std::round(dis2(gen));
+        }
+        // Ensure the values are within the range of the data vector
+        if (data[i] < 0) {
+            data[i] = 0;
+        } else if (data[i] >= static_cast<int>(size)) {
+            data[i] = size - 1;
+        }
+    }
+    
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers with an exponential distribution.
+ * The distribution has a lambda parameter of 1/(size/10).
+ * The range of the distribution is from 0 to size-1.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of size integers with an exponential distribution
+ */
+inline std::vector<int> generateExponentialData(std::size_t size, std::uint64_t seed) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+    
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+    
+    // Create an exponential distribution with lambda parameter of 1/(size/10)
+    std::exponential_distribution<> dis(1.0 / (size / 10));
+    
+    // Generate random integers and store them in the data vector
+    for (std::size_t i = 0; i < size; ++i) {
+        // Generate a random integer using the exponential distribution
+        data[i] = std::round(dis(gen));
+        // Ensure the values are within the range of the data vector
+        if (data[i] < 0) {
+            data[i] = 0;
+        } else if (data[i] >= static_cast<int>(size)) {
+            data[i] = size - 1;
+        }
+    }
+    
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers with a normal distribution.
+ * The distribution is centered at size / 2 and has a standard deviation of size / 10.
+ * The generated values are truncated to the range of the data vector.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of size integers with a normal distribution
+ */
+inline std::vector<int> generateNormalData(std::size_t size, std::uint64_t seed) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+    
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+    
+    // Create a normal distribution with a mean of size / 2 and a standard deviation of size / 10
+    std::normal_distribution<> dis(size / 2, size / 10);
+    
+    // Generate random integers and store them in the data vector
+    for (std::size_t i = 0; i < size; ++i) {
+        // Generate a random integer using the normal distribution
+        data[i] = static_cast<int>(dis(gen));
+        // Ensure the values are within the range of the data vector
+        if (data[i] < 0) {
+            data[i] = 0; // truncate values less than 0
+        } else if (data[i] >= static_cast<int>(size)) {
+            data[i] = size - 1; // truncate values greater than or equal to size
+        }
+    }
+    
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers with the values reversed.
+ *
+ * @param size The size of the vector to generate
+ * @return A vector of size integers with reversed values
+ */
+inline std::vector<int> generateReversedData(std::size_t size) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+    
+    // Populate the vector with reversed values
+    for (std::size_t i = 0; i < size; ++i) {
+        // Calculate the index of the value to be placed at position i
+        std::size_t reversedIndex = size - i - 1;
+        // Set the value at position i to the reversed value
+        data[i] = reversedIndex;
+    }
+    
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers in ascending order.
+ *
+ * @param size The size of the vector to generate
+ * @return A vector of the integers 0 to size-1 in order
+ */
+inline std::vector<int> generateSortedData(std::size_t size) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+
+    // Populate the vector with ascending values
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<int>(i);
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers in ascending order except for
+ * size/100 random pairs of elements swapped with each other.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of nearly sorted integers
+ */
+inline std::vector<int> generateNearlySortedData(std::size_t size, std::uint64_t seed) {
+    // Start from sorted data
+    std::vector<int> data = generateSortedData(size);
+    if (size < 2) {
+        return data;
+    }
+
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+
+    // Swap 1% of random pairs
+    std::uniform_int_distribution<std::size_t> dis(0, size - 1);
+    for (std::size_t i = 0; i < size / 100; ++i) {
+        std::swap(data[dis(gen)], data[dis(gen)]);
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers made of 10 ascending ramps of equal
+ * length, each running from 0 upwards.
+ *
+ * @param size The size of the vector to generate
+ * @return A vector of size integers shaped like a sawtooth wave
+ */
+inline std::vector<int> generateSawtoothData(std::size_t size) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+
+    // Populate the vector with ramps of size/10 values
+    std::size_t period = std::max<std::size_t>(size / 10, 1);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<int>(i % period);
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers drawn uniformly from 1 to 100, so
+ * every key is heavily duplicated, like status codes or bucket ids.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of size integers with at most 100 distinct values
+ */
+inline std::vector<int> generateDuplicateData(std::size_t size, std::uint64_t seed) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+
+    // Create a uniform integer distribution with a range of 1 to 100
+    std::uniform_int_distribution<> dis(1, 100);
+
+    // Generate random integers and store them in the data vector
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = dis(gen);
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers that ascend to the middle and
+ * descend back, like organ pipes.
+ *
+ * @param size The size of the vector to generate
+ * @return A vector of size integers shaped like a pyramid
+ */
+inline std::vector<int> generateOrganPipeData(std::size_t size) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+
+    // Count up to the middle and down again
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<int>(std::min(i, size - 1 - i));
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size integers drawn uniformly from 10 values
+ * spread over 0 to size-1.
+ *
+ * @param size The size of the vector to generate
+ * @param seed The seed of the generator
+ * @return A vector of size integers with at most 10 distinct values
+ */
+inline std::vector<int> generateFewUniqueData(std::size_t size, std::uint64_t seed) {
+    // Create a vector to store the generated data
+    std::vector<int> data(size);
+
+    // Create a mersenne twister generator from the seed
+    std::mt19937 gen = seededGenerator(seed);
+
+    // Pick one of 10 evenly spaced values for every element
+    std::uniform_int_distribution<> dis(0, 9);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<int>(dis(gen) * (size / 10));
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * Generates a vector of size copies of size/2.
+ *
+ * @param size The size of the vector to generate
+ * @return A vector of size equal integers
+ */
+inline std::vector<int> generateAllEqualData(std::size_t size) {
+    return std::vector<int>(size, static_cast<int>(size / 2));
+}
+
+/**
+ * Generates a vector of size integers that drives the default pivot rule
+ * (hqsort::MinMaxProbePivot) to its worst case: every partition splits
+ * only a few elements off the range, so an unguarded sort takes quadratic
+ * time and linear recursion depth.
+ *
+ * The data is built by partitioning element slots whose values are not yet
+ * decided, smaller than every decided value. Before each partition, the
+ * undecided slots the pivot rule probes get the largest values still
+ * free, so the pivot lands just below them and only they pass it. The
+ * larger side is partitioned next, exactly as the sort will do it; the
+ * slots never probed get the remaining values at the end.
+ *
+ * @param size The size of the vector to generate
+ * @return A vector of size integers ordered against the pivot rule
+ */
+inline std::vector<int> generateKillerData(std::size_t size) {
+    // A slot remembers where its element starts; value 0 marks it undecided
+    struct Slot {
+        int value;
+        std::size_t origin;
+    };
+    std::vector<Slot> slots(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        slots[i] = {0, i};
+    }
+
+    hqsort::KeyCompare<std::less<>, int Slot::*> keys{{}, &Slot::value};
+    int nextValue = static_cast<int>(size);
+    auto first = slots.begin();
+    auto last = slots.end();
+    while (last - first >= 4) {
+        // Decide the probed slots, largest value first
+        auto mid = first + (last - first - 1) / 2;
+        for (auto probe : {first, mid - 1, mid, last - 1}) {
+            if (probe->value == 0) {
+                probe->value = nextValue--;
+            }
+        }
+
+        // Partition as the sort does and follow its larger side
+        int pivot = hqsort::MinMaxProbePivot::calculatePivot(first, last, keys);
+        auto split = hqsort::partition(first, last, pivot, keys);
+        if (split - first >= last - split) {
+            last = split;
+        } else {
+            first = split;
+        }
+    }
+
+    // Give the slots never probed the values left, and restore their order
+    for (Slot& slot : slots) {
+        if (slot.value == 0) {
+            slot.value = nextValue--;
+        }
+    }
+    std::vector<int> data(size);
+    for (const Slot& slot : slots) {
+        data[slot.origin] = slot.value;
+    }
+
+    // Return the generated data vector
+    return data;
+}
+
+/**
+ * A benchmark distribution: its name and seeded generator. Random
+ * distributions are drawn with another seed for every iteration; the
+ * others are the same every time.
+ */
+struct Distribution {
+    const char* name;
+    std::vector<int> (*generate)(std::size_t, std::uint64_t);
+    bool random;
+};
+
+/**
+ * The named catalogue of workloads: the distributions of the paper, the
+ * classic presorted and low-entropy shapes, and the regression datasets
+ * added with the library features.
+ */
+inline const std::vector<Distribution> catalogue = {
+    {"Uniform", generateUniformData, true},
+    {"Normal", generateNormalData, true},
+    {"Exponential", generateExponentialData, true},
+    {"Bimodal", generateBimodalData, true},
+    {"Reversed", [](std::size_t size, std::uint64_t) { return generateReversedData(size); }, false},
+    {"Sorted", [](std::size_t size, std::uint64_t) { return generateSortedData(size); }, false},
+    {"Organ Pipe", [](std::size_t size, std::uint64_t) { return generateOrganPipeData(size); }, false},
+    {"Few Unique", generateFewUniqueData, true},
+    {"All Equal", [](std::size_t size, std::uint64_t) { return generateAllEqualData(size); }, false},
+    {"Nearly Sorted", generateNearlySortedData, true},
+    {"Sawtooth", [](std::size_t size, std::uint64_t) { return generateSawtoothData(size); }, false},
+    {"Duplicates", generateDuplicateData, true},
+    {"Killer", [](std::size_t size, std::uint64_t) { return generateKillerData(size); }, false}
+};
+
+/**
+ * Returns the name of a distribution in lower case without spaces, as in
+ * file names and on the command line: "organpipe" for "Organ Pipe".
+ */
+inline std::string distributionKey(const std::string& name) {
+    std::string key;
+    for (char c : name) {
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    return key;
+}
+
+/**
+ * Finds a distribution of the catalogue by name, ignoring case, spaces,
+ * hyphens and underscores.
+ *
+ * @param name The name to look up
+ * @return The distribution, or nullptr if the catalogue has none by that name
+ */
+inline const Distribution* findDistribution(const std::string& name) {
+    for (const Distribution& distribution : catalogue) {
+        if (distributionKey(distribution.name) == distributionKey(name)) {
+            return &distribution;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * The distributions of the paper, in the order of its tables, taken from
+ * the catalogue by name.
+ */
+inline const std::vector<Distribution> paperDistributions = [] {
+    std::vector<Distribution> distributions;
+    for (const char* name : {"Uniform", "Normal", "Exponential", "Bimodal", "Reversed"}) {
+        distributions.push_back(*findDistribution(name));
+    }
+    return distributions;
+}();
+
+/**
+ * Derives the seed of one dataset from the seed of a run, so every
+ * distribution, size and iteration gets its own independent stream and
+ * adding a distribution does not change the others.
+ *
+ * @param seed The seed of the run
+ * @param name The name of the distribution
+ * @param size The size of the dataset
+ * @param iteration The iteration the dataset is for
+ * @return The seed of the dataset
+ */
+inline std::uint64_t datasetSeed(std::uint64_t seed, const std::string& name, std::size_t size, int iteration) {
+    // splitmix64 over the run seed and the dataset's coordinates
+    auto mix = [](std::uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    };
+    std::uint64_t hash = mix(seed + 0x9E3779B97F4A7C15ull);
+    for (char c : distributionKey(name)) {
+        hash = mix(hash + static_cast<unsigned char>(c));
+    }
+    hash = mix(hash + size);
+    return mix(hash + static_cast<std::uint64_t>(iteration));
+}
+
+/**
+ * Bumped whenever a generator changes, so stale cached datasets are not
+ * reused.
+ */
+constexpr int kGeneratorVersion = 1;
+
+/**
+ * Returns a dataset of a distribution for a run seed and iteration.
+ *
+ * Datasets are cached as binary datasets in cacheDirectory: a dataset in
+ * the cache is mapped and copied instead of generated, and a generated one
+ * is added to it. Distributions that are not random have one dataset per
+ * size whatever the seed and iteration. An empty cacheDirectory turns the
+ * cache off.
+ *
+ * @param distribution The distribution to draw from
+ * @param size The size of the dataset
+ * @param seed The seed of the run
+ * @param iteration The iteration the dataset is for
+ * @param cacheDirectory The cache, or "" for none
+ * @return The dataset
+ */
+inline std::vector<int> loadDataset(const Distribution& distribution, std::size_t size, std::uint64_t seed,
+                                    int iteration, const std::string& cacheDirectory) {
+    std::uint64_t dataSeed = distribution.random ? datasetSeed(seed, distribution.name, size, iteration) : 0;
+    if (cacheDirectory.empty()) {
+        return distribution.generate(size, dataSeed);
+    }
+
+    std::string fileName = distributionKey(distribution.name) + "-" + std::to_string(size) + "-v" +
+                           std::to_string(kGeneratorVersion);
+    if (distribution.random) {
+        fileName += "-" + std::to_string(seed) + "-" + std::to_string(iteration);
+    }
+    std::filesystem::path path = std::filesystem::path(cacheDirectory) / (fileName + ".bin");
+
+    hqsort::MappedDataset<int> cached;
+    if (cached.open(path.string(), true) && cached.size() == size) {
+        return cached.toVector();
+    }
+    cached.close();
+
+    // Cache misses are generated; failing to cache them only costs time
+    std::vector<int> data = distribution.generate(size, dataSeed);
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+    hqsort::writeBinaryDataset(path.string(), data.data(), data.size());
+    return data;
+}
+
+#endif // BENCHMARK_GENERATORS_HPP
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+#include "../include/hqsort/hqsort.hpp"
+#include "../include/hqsort/parallel.hpp"
+#include "generators.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * Runs the parallel sorting tests for different datasets, sizes and thread
+ * counts, and reports the speedup of every thread count over one thread.
+ * Every sorted output is checked, so a speedup cannot come from a sort
+ * that skipped work.
+ *
+ * @param file The output file to write the results to
+ * @param maxThreads The largest thread count to test
+ * @return false if a sort left its data unsorted
+ */
+bool runTests(ofstream& file, unsigned maxThreads) {
+    // Define the sizes to test
+    vector<size_t> sizes = {100000, 1000000, 10000000};
+    const int iterations = 3; // Number of times to run each test
+    const vector<Distribution>& distributions = paperDistributions;
+
+    // Run tests for each size
+    for (size_t size : sizes) {
+        file << "Data Size: " << size << endl;
+        cout << "Data Size: " << size << endl;
+
+        // Total durations for each dataset and thread count
+        vector<vector<long long>> totalDurations(distributions.size(), vector<long long>(maxThreads + 1, 0));
+
+        // Run tests for each iteration
+        for (int i = 0; i < iterations; ++i) {
+            // Generate datasets from the default seed
+            vector<vector<int>> datasets;
+            for (const Distribution& distribution : distributions) {
+                datasets.push_back(distribution.generate(size, datasetSeed(kDefaultSeed, distribution.name, size, i)));
+            }
+
+            // Sort every dataset with each thread count
+            for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+                hqsort::ParallelOptions options;
+                options.threads = threads;
+
+                for (size_t j = 0; j < datasets.size(); ++j) {
+                    vector<int> data = datasets[j];
+
+                    auto startSorting = high_resolution_clock::now();
+                    hqsort::parallelSort<hqsort::Proposed10>(data.begin(), data.end(), options);
+                    auto stopSorting = high_resolution_clock::now();
+
+                    totalDurations[j][threads] += duration_cast<nanoseconds>(stopSorting - startSorting).count();
+
+                    if (!is_sorted(data.begin(), data.end())) {
+                        cerr << distributions[j].name << " with " << threads << " threads is not sorted" << endl;
+                        file << distributions[j].name << " with " << threads << " threads is not sorted" << endl;
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // Calculate and print the average durations and speedup curves
+        cout << "Average runtimes:" << endl;
+        file << "Average runtimes:" << endl;
+
+        for (size_t j = 0; j < distributions.size(); ++j) {
+            double baseline = static_cast<double>(totalDurations[j][1]) / iterations;
+            for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+                double averageDuration = static_cast<double>(totalDurations[j][threads]) / iterations;
+                double speedup = baseline / averageDuration;
+                cout << distributions[j].name << " Threads " << threads << ": " << fixed << setprecision(2) << averageDuration << " nanoseconds, speedup " << speedup << "x" << endl;
+                file << distributions[j].name << " Threads " << threads << ": " << fixed << setprecision(2) << averageDuration << " nanoseconds, speedup " << speedup << "x" << endl;
+            }
+        }
+
+        cout << "---------------------------------" << endl;
+        file << "---------------------------------" << endl;
+    }
+    return true;
+}
+
+/**
+ * @brief Main function that runs the tests and writes the results to a file.
+ *
+ * The largest thread count defaults to the number of hardware threads and
+ * can be given as the first argument.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    unsigned maxThreads = argc > 1 ? stoul(argv[1]) : thread::hardware_concurrency();
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    // Open the output file for writing
+    ofstream file("parallel_quick_sort_test_results.txt");
+
+    // Check if the file was successfully opened
+    if (file.is_open()) {
+        // Record the seed and run the tests
+        file << "Seed: " << kDefaultSeed << endl;
+        cout << "Seed: " << kDefaultSeed << endl;
+        if (!runTests(file, maxThreads)) {
+            return 1;
+        }
+
+        // Close the file
+        file.close();
+    } else {
+        // Print an error message if the file could not be opened
+        cerr << "Unable to open file for writing." << endl;
+    }
+
+    return 0;
+}
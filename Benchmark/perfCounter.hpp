@@ -0,0 +1,266 @@
+#ifndef BENCHMARK_PERF_COUNTER_HPP
+#define BENCHMARK_PERF_COUNTER_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Hardware events PerfCounter can count.
+ */
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1DMisses,   // Level 1 data cache read misses
+    LLCMisses,   // Last level cache misses
+    DTLBMisses   // Data TLB read misses
+};
+
+/**
+ * Every PerfEvent, in the order the benchmarks report them.
+ */
+const std::vector<PerfEvent> allPerfEvents = {PerfEvent::Cycles,    PerfEvent::Instructions, PerfEvent::BranchMisses,
+                                              PerfEvent::L1DMisses, PerfEvent::LLCMisses,    PerfEvent::DTLBMisses};
+
+/**
+ * Returns the name of an event for report headings.
+ */
+inline const char* perfEventName(PerfEvent event) {
+    switch (event) {
+    case PerfEvent::Cycles:
+        return "Cycles";
+    case PerfEvent::Instructions:
+        return "Instructions";
+    case PerfEvent::BranchMisses:
+        return "Branch misses";
+    case PerfEvent::L1DMisses:
+        return "L1 data misses";
+    case PerfEvent::LLCMisses:
+        return "LLC misses";
+    case PerfEvent::DTLBMisses:
+        return "dTLB misses";
+    }
+    return "";
+}
+
+/**
+ * One hardware performance counter of the calling thread, read through
+ * perf_event_open.
+ *
+ * Counters are often unavailable (non-Linux hosts, containers, or a strict
+ * kernel.perf_event_paranoid setting). The counter then reports
+ * available() == false and stop() returns -1, so callers can print "n/a"
+ * instead of failing.
+ *
+ * When more events are open than the PMU has counters, the kernel
+ * multiplexes them; stop() scales the count by the share of the time the
+ * counter actually ran.
+ */
+class PerfCounter {
+public:
+    /**
+     * Opens a counter for the calling thread, counting user space only.
+     *
+     * @param event The event to count
+     */
+    explicit PerfCounter(PerfEvent event) {
+#ifdef __linux__
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        switch (event) {
+        case PerfEvent::Cycles:
+            attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::Instructions:
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::BranchMisses:
+            attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::L1DMisses:
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PerfEvent::LLCMisses:
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfEvent::DTLBMisses:
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        }
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        if (fd_ < 0) {
+            error_ = errno;
+        }
+#else
+        (void)event;
+        error_ = ENOSYS;
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    /**
+     * Returns true if the counter could be opened.
+     */
+    bool available() const {
+        return fd_ >= 0;
+    }
+
+    /**
+     * Returns the errno of a failed open, 0 if the counter is available.
+     */
+    int error() const {
+        return error_;
+    }
+
+    /**
+     * Resets the counter to zero and starts counting.
+     */
+    void start() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * Stops counting and returns the count since start().
+     *
+     * @return The event count, or -1 if the counter is unavailable or was
+     *         never scheduled on the PMU
+     */
+    long long stop() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t values[3] = {}; // Count, time enabled, time running
+            if (read(fd_, values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) && values[2] > 0) {
+                if (values[2] == values[1]) {
+                    return static_cast<long long>(values[0]);
+                }
+                return static_cast<long long>(static_cast<double>(values[0]) * values[1] / values[2]);
+            }
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int fd_ = -1;
+    int error_ = 0;
+};
+
+/**
+ * Several PerfCounters started and stopped together. Each event is opened
+ * on its own, so an event the host does not support (the cache events in
+ * many virtual machines) leaves the others working.
+ */
+class PerfCounterSet {
+public:
+    /**
+     * Opens a counter for every event for the calling thread.
+     *
+     * @param events The events to count
+     */
+    explicit PerfCounterSet(const std::vector<PerfEvent>& events) : events_(events) {
+        for (PerfEvent event : events) {
+            counters_.emplace_back(new PerfCounter(event));
+        }
+    }
+
+    const std::vector<PerfEvent>& events() const {
+        return events_;
+    }
+
+    /**
+     * Returns true if the counter of events()[i] could be opened.
+     */
+    bool available(std::size_t i) const {
+        return counters_[i]->available();
+    }
+
+    /**
+     * Returns true if any counter could be opened.
+     */
+    bool anyAvailable() const {
+        for (const auto& counter : counters_) {
+            if (counter->available()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns the errno of the first counter that failed to open, 0 if
+     * all are available.
+     */
+    int error() const {
+        for (const auto& counter : counters_) {
+            if (!counter->available()) {
+                return counter->error();
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Resets and starts every counter.
+     */
+    void start() {
+        for (auto& counter : counters_) {
+            counter->start();
+        }
+    }
+
+    /**
+     * Stops every counter, in the reverse order of start() so the counts
+     * cover the same code.
+     *
+     * @param counts Receives the count of each event, -1 where unavailable
+     */
+    void stop(std::vector<long long>& counts) {
+        counts.resize(counters_.size());
+        for (std::size_t i = counters_.size(); i-- > 0;) {
+            counts[i] = counters_[i]->stop();
+        }
+    }
+
+private:
+    std::vector<PerfEvent> events_;
+    std::vector<std::unique_ptr<PerfCounter>> counters_;
+};
+
+#endif // BENCHMARK_PERF_COUNTER_HPP
@@ -0,0 +1,548 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <tuple>
+
+#include "../include/hqsort/hqsort.hpp"
+#include "../include/hqsort/binary_dataset.hpp"
+#include "../include/hqsort/external_sort.hpp"
+#include "../include/hqsort/int_reader.hpp"
+#include "../include/hqsort/parallel.hpp"
+#include "../include/hqsort/stream_sort.hpp"
+#include "../include/hqsort/tuning.hpp"
+#include "generators.hpp"
+
+using namespace std;
+
+/**
+ * Checks run and failed so far; the first failures are printed.
+ */
+long long checks = 0;
+long long failures = 0;
+
+/**
+ * Records one check and prints it if it failed.
+ *
+ * @param passed Whether the check passed
+ * @param description What was checked, for the failure report
+ */
+void check(bool passed, const string& description) {
+    ++checks;
+    if (!passed) {
+        if (++failures <= 50) {
+            cerr << "FAILED: " << description << endl;
+        }
+    }
+}
+
+/**
+ * An element sorted by a projected key, with a payload that must travel
+ * with it.
+ */
+struct Record {
+    int key;
+    int id;
+
+    bool operator<(const Record& other) const {
+        return tie(key, id) < tie(other.key, other.id);
+    }
+    bool operator==(const Record& other) const {
+        return key == other.key && id == other.id;
+    }
+};
+
+/**
+ * Converts a dataset of ints to another element type, keeping its shape.
+ */
+template <class T>
+vector<T> convert(const vector<int>& data) {
+    vector<T> converted;
+    converted.reserve(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        int value = data[i];
+        if constexpr (is_same_v<T, string>) {
+            converted.push_back(to_string(value));
+        } else if constexpr (is_same_v<T, Record>) {
+            converted.push_back({value, static_cast<int>(i)});
+        } else if constexpr (is_same_v<T, unsigned>) {
+            converted.push_back(static_cast<unsigned>(value) ^ 0x80000000u);
+        } else if constexpr (is_same_v<T, int64_t>) {
+            converted.push_back(static_cast<int64_t>(value) * 4099 - (int64_t(1) << 40));
+        } else if constexpr (is_same_v<T, int16_t>) {
+            converted.push_back(static_cast<int16_t>(value % 30000));
+        } else if constexpr (is_floating_point_v<T>) {
+            converted.push_back(static_cast<T>(value) / 7);
+        } else {
+            converted.push_back(static_cast<T>(value));
+        }
+    }
+    return converted;
+}
+
+/**
+ * Checks that output is input sorted: its keys are those of std::sort on
+ * the input, and it holds the same elements.
+ *
+ * @param input The unsorted elements
+ * @param output The elements after the sort under test
+ * @param comp The ordering of the keys
+ * @param proj The projection from an element to its key
+ * @param description The case, for the failure report
+ */
+template <class T, class Compare, class Projection>
+void checkSorted(const vector<T>& input, const vector<T>& output, Compare comp, Projection proj,
+                 const string& description) {
+    vector<T> expected = input;
+    sort(expected.begin(), expected.end(),
+         [&](const T& a, const T& b) { return comp(invoke(proj, a), invoke(proj, b)); });
+    bool sameKeys = expected.size() == output.size() &&
+                    equal(expected.begin(), expected.end(), output.begin(),
+                          [&](const T& a, const T& b) { return !comp(invoke(proj, a), invoke(proj, b)) &&
+                                                               !comp(invoke(proj, b), invoke(proj, a)); });
+
+    vector<T> inputElements = input;
+    vector<T> outputElements = output;
+    sort(inputElements.begin(), inputElements.end());
+    sort(outputElements.begin(), outputElements.end());
+    check(sameKeys && inputElements == outputElements, description);
+}
+
+/**
+ * A policy under test and its name.
+ */
+template <class Policy>
+struct PolicyCase {
+    using type = Policy;
+    const char* name;
+};
+
+/**
+ * Policies for arithmetic keys: every pivot rule, partition scheme, leaf
+ * routine and option of the library, and combinations of them.
+ */
+const auto numericPolicies = make_tuple(
+    PolicyCase<hqsort::DefaultPolicy>{"default"},
+    PolicyCase<hqsort::Proposed10>{"proposed10"},
+    PolicyCase<hqsort::Proposed50>{"proposed50"},
+    PolicyCase<hqsort::Proposed100>{"proposed100"},
+    PolicyCase<hqsort::HossainPolicy<>>{"hossain"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MeanOfHalvesPivot>>{"mean"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MedianOfThreePivot>>{"median3"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::NintherPivot>>{"ninther"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::SampledPivot<9>>>{"sample9"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::BlockPartition>>{"block"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::SimdPartition>>{"simd"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::ThreeWayPartition>>{"threeway"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::DualPivotPartition>>{"dualpivot"},
+    PolicyCase<hqsort::NetworkPolicy<16>>{"network16"},
+    PolicyCase<hqsort::NetworkPolicy<64>>{"network64"},
+    PolicyCase<hqsort::DepthLimitedPolicy<hqsort::Proposed10>>{"guarded"},
+    PolicyCase<hqsort::DepthLimitedPolicy<hqsort::HossainPolicy<hqsort::MeanOfHalvesPivot>>>{"guarded hossain"},
+    PolicyCase<hqsort::AdaptivePolicy<hqsort::Proposed10>>{"adaptive"},
+    PolicyCase<hqsort::RadixPolicy<hqsort::Proposed10>>{"radix"},
+    PolicyCase<hqsort::CountingPolicy<hqsort::Proposed10>>{"counting"},
+    PolicyCase<hqsort::CountingPolicy<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::DualPivotPartition>>>{
+        "counting dualpivot"},
+    PolicyCase<hqsort::CountingPolicy<hqsort::ProposedPolicy<10, hqsort::MinMaxProbePivot, hqsort::ThreeWayPartition>>>{
+        "counting threeway"},
+    PolicyCase<hqsort::AdaptivePolicy<hqsort::RadixPolicy<hqsort::NetworkPolicy<32>>>>{"adaptive radix network"});
+
+/**
+ * Policies for any comparable key: the pivot rules that pick an actual key.
+ */
+const auto genericPolicies = make_tuple(
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MedianOfThreePivot>>{"median3"},
+    PolicyCase<hqsort::ProposedPolicy<3, hqsort::NintherPivot>>{"ninther hossain"},
+    PolicyCase<hqsort::ProposedPolicy<50, hqsort::SampledPivot<9>>>{"sample9"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::NintherPivot, hqsort::BlockPartition>>{"ninther block"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MedianOfThreePivot, hqsort::ThreeWayPartition>>{"median3 threeway"},
+    PolicyCase<hqsort::ProposedPolicy<10, hqsort::MedianOfThreePivot, hqsort::DualPivotPartition>>{"dualpivot"},
+    PolicyCase<hqsort::NetworkPolicy<16, hqsort::NintherPivot>>{"ninther network16"},
+    PolicyCase<hqsort::DepthLimitedPolicy<hqsort::ProposedPolicy<10, hqsort::MedianOfThreePivot>>>{"guarded"},
+    PolicyCase<hqsort::AdaptivePolicy<hqsort::ProposedPolicy<10, hqsort::NintherPivot>>>{"adaptive"},
+    PolicyCase<hqsort::RadixPolicy<hqsort::CountingPolicy<hqsort::ProposedPolicy<10, hqsort::NintherPivot>>>>{
+        "radix counting"});
+
+/**
+ * The sizes every distribution is sorted at: the edge cases around the
+ * manualSort, network and insertion sort cutoffs, and larger ranges.
+ */
+const vector<size_t> sortSizes = {0, 1, 2, 3, 4, 5, 7, 8, 10, 11, 16, 17, 31, 33, 64, 65, 100, 129, 1000, 4097, 10000};
+
+/**
+ * Sorts every distribution of the catalogue at every size with each
+ * policy, by std::less and std::greater, and checks the results.
+ *
+ * @param typeName The element type, for the failure report
+ * @param policies The policies to test
+ * @param proj The projection from an element to its key
+ */
+template <class T, class Policies, class Projection = hqsort::identity>
+void testSort(const string& typeName, const Policies& policies, Projection proj = {}) {
+    for (const Distribution& distribution : catalogue) {
+        for (size_t size : sortSizes) {
+            vector<T> input = convert<T>(distribution.generate(size, datasetSeed(kDefaultSeed, distribution.name, size, 0)));
+            string where = typeName + " " + distribution.name + " " + to_string(size);
+
+            apply([&](const auto&... cases) {
+                auto run = [&](const auto& policyCase) {
+                    using Policy = typename decay_t<decltype(policyCase)>::type;
+                    vector<T> ascending = input;
+                    hqsort::sort<Policy>(ascending.begin(), ascending.end(), less<>(), proj);
+                    checkSorted(input, ascending, less<>(), proj, string(policyCase.name) + " " + where);
+
+                    vector<T> descending = input;
+                    hqsort::sort<Policy>(descending.begin(), descending.end(), greater<>(), proj);
+                    checkSorted(input, descending, greater<>(), proj, string(policyCase.name) + " greater " + where);
+                };
+                (run(cases), ...);
+            }, policies);
+        }
+    }
+}
+
+/**
+ * Radix sorts ranges too large for the scratch buffer a thread keeps, and
+ * then a small one with the kept buffer again.
+ */
+void testLargeRadixSort() {
+    using Radix = hqsort::RadixPolicy<hqsort::Proposed10>;
+    for (const char* name : {"Uniform", "Normal", "Duplicates"}) {
+        const Distribution* distribution = findDistribution(name);
+        for (size_t size : {size_t(1) << 19, size_t(5000)}) {
+            vector<int> input = distribution->generate(size, datasetSeed(kDefaultSeed, name, size, 0));
+            vector<int> data = input;
+            hqsort::sort<Radix>(data.begin(), data.end(), greater<>());
+            checkSorted(input, data, greater<>(), hqsort::identity(),
+                        "radix greater " + string(name) + " " + to_string(size));
+
+            vector<Record> records = convert<Record>(input);
+            vector<Record> sortedRecords = records;
+            hqsort::sort<Radix>(sortedRecords.begin(), sortedRecords.end(), less<>(), &Record::key);
+            checkSorted(records, sortedRecords, less<>(), &Record::key,
+                        "radix projection " + string(name) + " " + to_string(size));
+        }
+    }
+}
+
+/**
+ * Runs parallelSort with small grains so every size splits into tasks and
+ * the large ones are partitioned by all threads.
+ */
+void testParallelSort() {
+    hqsort::ParallelOptions options;
+    options.grainSize = 512;
+    options.parallelPartitionCutoff = 8192;
+    options.partitionBlockSize = 1024;
+
+    for (const Distribution& distribution : catalogue) {
+        for (size_t size : {size_t(0), size_t(10), size_t(5000), size_t(100000)}) {
+            vector<int> input = distribution.generate(size, datasetSeed(kDefaultSeed, distribution.name, size, 0));
+            vector<Record> records = convert<Record>(input);
+            for (unsigned threads : {1u, 2u, 4u}) {
+                options.threads = threads;
+                string where = string(distribution.name) + " " + to_string(size) + " threads " + to_string(threads);
+
+                vector<int> data = input;
+                hqsort::parallelSort<hqsort::Proposed10>(data.begin(), data.end(), options);
+                checkSorted(input, data, less<>(), hqsort::identity(), "parallel proposed10 " + where);
+
+                data = input;
+                hqsort::parallelSort<hqsort::DepthLimitedPolicy<hqsort::ProposedPolicy<10, hqsort::NintherPivot>>>(
+                    data.begin(), data.end(), options, greater<>());
+                checkSorted(input, data, greater<>(), hqsort::identity(), "parallel guarded greater " + where);
+
+                data = input;
+                hqsort::parallelSort<hqsort::AdaptivePolicy<hqsort::NetworkPolicy<16>>>(data.begin(), data.end(),
+                                                                                        options);
+                checkSorted(input, data, less<>(), hqsort::identity(), "parallel adaptive network " + where);
+
+                vector<Record> sortedRecords = records;
+                hqsort::parallelSort<hqsort::Proposed10>(sortedRecords.begin(), sortedRecords.end(), options, less<>(),
+                                                         &Record::key);
+                checkSorted(records, sortedRecords, less<>(), &Record::key, "parallel projection " + where);
+            }
+        }
+    }
+}
+
+/**
+ * Sorts with tunedSort under every partition scheme and leaf routine a
+ * profile can select.
+ */
+void testTunedSort() {
+    vector<int> input = generateUniformData(20000, datasetSeed(kDefaultSeed, "Uniform", 20000, 0));
+    for (hqsort::PartitionKind partition : {hqsort::PartitionKind::Hoare, hqsort::PartitionKind::Block,
+                                            hqsort::PartitionKind::Simd, hqsort::PartitionKind::ThreeWay,
+                                            hqsort::PartitionKind::DualPivot}) {
+        for (hqsort::LeafKind leaf : {hqsort::LeafKind::Insertion, hqsort::LeafKind::Network}) {
+            hqsort::TuningProfile profile;
+            profile.cutoff = 24;
+            profile.partition = partition;
+            profile.leaf = leaf;
+            hqsort::useTuningProfile(profile);
+
+            vector<int> data = input;
+            hqsort::tunedSort(data.begin(), data.end());
+            checkSorted(input, data, less<>(), hqsort::identity(),
+                        string("tunedSort ") + hqsort::toString(partition) + "/" + hqsort::toString(leaf));
+        }
+    }
+    hqsort::useTuningProfile(hqsort::TuningProfile());
+}
+
+/**
+ * Loads tuning profiles: valid settings are read, and malformed lines and
+ * cutoffs out of range are refused without changing the profile.
+ *
+ * @param directory Where to put the profile
+ */
+void testTuningProfiles(const filesystem::path& directory) {
+    string path = (directory / "hqsort.profile").string();
+    auto load = [&](const string& text, hqsort::TuningProfile& profile) {
+        {
+            ofstream file(path);
+            file << text;
+        }
+        return hqsort::loadTuningProfile(path, profile);
+    };
+
+    hqsort::TuningProfile profile;
+    check(load("# tuned\ncutoff=1024\npartition=dualpivot\nleaf=network\n", profile) && profile.cutoff == 1024 &&
+              profile.partition == hqsort::PartitionKind::DualPivot && profile.leaf == hqsort::LeafKind::Network,
+          "loadTuningProfile reads the settings");
+    for (const char* text : {"cutoff=1025\n", "cutoff=100000000\n", "cutoff=-1\n", "cutoff=99999999999999999999\n",
+                               "cutoff=\n", "partition=quick\n", "leaf\n"}) {
+        hqsort::TuningProfile unchanged = profile;
+        check(!load(text, unchanged) && unchanged.cutoff == 1024, string("loadTuningProfile refuses ") + text);
+    }
+    filesystem::remove(path);
+}
+
+/**
+ * Writes ints as a text file, one per line, with extra lines in between.
+ */
+void writeText(const string& path, const vector<int>& values, const vector<string>& extraLines) {
+    ofstream file(path);
+    for (size_t i = 0; i < values.size(); ++i) {
+        file << values[i] << '\n';
+        if (i < extraLines.size()) {
+            file << extraLines[i] << '\n';
+        }
+    }
+}
+
+/**
+ * Sorts text files with externalSort through many runs and merge passes,
+ * in one chunk, and empty, and checks the sorted files and the skipped
+ * lines.
+ *
+ * @param directory Where to put the files
+ */
+void testExternalSort(const filesystem::path& directory) {
+    string inputPath = (directory / "external_input.txt").string();
+    string outputPath = (directory / "external_output.txt").string();
+    vector<int> input = generateDuplicateData(50000, datasetSeed(kDefaultSeed, "Duplicates", 50000, 0));
+    vector<int> uniform = generateUniformData(50000, datasetSeed(kDefaultSeed, "Uniform", 50000, 0));
+    input.insert(input.end(), uniform.begin(), uniform.end());
+    writeText(inputPath, input, {"not a number", "", "99999999999", "0000000000000000000042"});
+    input.insert(input.begin() + 4, 42);
+
+    hqsort::ExternalSortOptions options;
+    options.tempDirectory = directory.string();
+    for (size_t memoryBudget : {size_t(16) << 10, size_t(16) << 20}) {
+        for (bool descending : {false, true}) {
+            options.memoryBudget = memoryBudget;
+            options.fanIn = 3;
+            hqsort::ExternalSortStats stats;
+            bool ok = descending ? hqsort::externalSort(inputPath, outputPath, options, stats, greater<>())
+                                 : hqsort::externalSort(inputPath, outputPath, options, stats);
+
+            vector<int> output;
+            hqsort::IntegerLoadStats loadStats;
+            bool loaded = hqsort::loadIntegers(outputPath, output, loadStats);
+            string where = "externalSort budget " + to_string(memoryBudget) + (descending ? " greater" : "");
+            check(ok && loaded, where + " succeeds");
+            check(stats.elements == input.size() && stats.malformedLines == 2, where + " counts");
+            check(memoryBudget > (size_t(1) << 20) || stats.mergePasses > 1, where + " merges in passes");
+            if (descending) {
+                checkSorted(input, output, greater<>(), hqsort::identity(), where);
+            } else {
+                checkSorted(input, output, less<>(), hqsort::identity(), where);
+            }
+        }
+    }
+
+    writeText(inputPath, {}, {});
+    hqsort::ExternalSortStats stats;
+    vector<int> output;
+    hqsort::IntegerLoadStats loadStats;
+    check(hqsort::externalSort(inputPath, outputPath, options, stats) &&
+              hqsort::loadIntegers(outputPath, output, loadStats) && output.empty(),
+          "externalSort of an empty file");
+    check(!hqsort::externalSort((directory / "missing.txt").string(), outputPath, options, stats),
+          "externalSort of a missing file fails");
+    filesystem::remove(inputPath);
+    filesystem::remove(outputPath);
+}
+
+/**
+ * Sorts text files with streamSort in small chunks on several threads and
+ * checks the output.
+ *
+ * @param directory Where to put the files
+ */
+void testStreamSort(const filesystem::path& directory) {
+    string inputPath = (directory / "stream_input.txt").string();
+    string outputPath = (directory / "stream_output.txt").string();
+    for (size_t size : {size_t(0), size_t(1), size_t(999), size_t(100000)}) {
+        vector<int> input = generateExponentialData(size, datasetSeed(kDefaultSeed, "Exponential", size, 0));
+        writeText(inputPath, input, {"x"});
+
+        hqsort::StreamSortOptions options;
+        options.chunkElements = 1000;
+        options.sortThreads = 2;
+        options.blockElements = 256;
+        hqsort::StreamSortStats stats;
+        FILE* in = fopen(inputPath.c_str(), "rb");
+        FILE* out = fopen(outputPath.c_str(), "wb");
+        bool ok = in != nullptr && out != nullptr && hqsort::streamSort(in, out, options, stats);
+        if (in != nullptr) {
+            fclose(in);
+        }
+        if (out != nullptr) {
+            fclose(out);
+        }
+
+        vector<int> output;
+        hqsort::IntegerLoadStats loadStats;
+        bool loaded = hqsort::loadIntegers(outputPath, output, loadStats);
+        string where = "streamSort " + to_string(size);
+        check(ok && loaded && stats.elements == size && stats.malformedLines == (size > 0 ? 1u : 0u),
+              where + " succeeds");
+        checkSorted(input, output, less<>(), hqsort::identity(), where);
+    }
+    filesystem::remove(inputPath);
+    filesystem::remove(outputPath);
+}
+
+/**
+ * Writes binary datasets and maps them back: the values round-trip, the
+ * mapping can be sorted without changing the file, and damaged files or
+ * the wrong element type are refused.
+ *
+ * @param directory Where to put the files
+ */
+template <class T>
+void testMappedDataset(const filesystem::path& directory, const string& typeName) {
+    string path = (directory / ("dataset_" + typeName + ".bin")).string();
+    for (size_t size : {size_t(0), size_t(1), size_t(1000), size_t(100000)}) {
+        vector<T> values = convert<T>(generateNormalData(size, datasetSeed(kDefaultSeed, "Normal", size, 0)));
+        string where = "MappedDataset<" + typeName + "> " + to_string(size);
+        check(hqsort::writeBinaryDataset(path, values.data(), values.size()), where + " writes");
+
+        hqsort::MappedDataset<T> mapped;
+        check(mapped.open(path, true) && mapped.toVector() == values, where + " round-trips");
+
+        // Sorting the mapping leaves the file as it was
+        hqsort::sort(mapped.begin(), mapped.end());
+        checkSorted(values, vector<T>(mapped.begin(), mapped.end()), less<>(), hqsort::identity(), where + " sorts");
+        mapped.close();
+        check(mapped.open(path, true) && mapped.toVector() == values, where + " file unchanged");
+        mapped.close();
+
+        if (size > 0) {
+            // Flip a byte of the values: only a verified open notices
+            {
+                fstream file(path, ios::in | ios::out | ios::binary);
+                streamoff offset = sizeof(hqsort::DatasetHeader) + sizeof(T) / 2;
+                file.seekg(offset);
+                char byte = static_cast<char>(file.get());
+                file.seekp(offset);
+                file.put(static_cast<char>(byte ^ 0x5a));
+            }
+            bool unverified = mapped.open(path);
+            mapped.close();
+            check(unverified && !mapped.open(path, true), where + " checksum");
+
+            // Cut the last value off
+            filesystem::resize_file(path, filesystem::file_size(path) - 1);
+            check(!mapped.open(path), where + " truncated");
+        }
+    }
+
+    vector<float> floats = {1.5f, -2.0f};
+    hqsort::writeBinaryDataset(path, floats.data(), floats.size());
+    hqsort::MappedDataset<T> mapped;
+    check(!mapped.open(path) && !mapped.error().empty(), "MappedDataset<" + typeName + "> refuses float data");
+    check(!mapped.open((directory / "missing.bin").string()), "MappedDataset<" + typeName + "> missing file");
+    filesystem::remove(path);
+}
+
+/**
+ * Parses integers with loadIntegers: signs, spaces, CRLF line ends,
+ * leading zeros, and lines that are skipped.
+ *
+ * @param directory Where to put the file
+ */
+void testLoadIntegers(const filesystem::path& directory) {
+    string path = (directory / "integers.txt").string();
+    {
+        ofstream file(path, ios::binary);
+        file << "42\n-7\n +3 \r\n\n0000000000000000000042\n-2147483648\n2147483647\n2147483648\n12a\n-\n+0";
+    }
+    vector<int> values;
+    hqsort::IntegerLoadStats stats;
+    bool ok = hqsort::loadIntegers(path, values, stats);
+    check(ok && values == vector<int>({42, -7, 3, 42, -2147483648, 2147483647, 0}), "loadIntegers values");
+    check(stats.malformedLines == 3 && stats.errors.size() == 3 && stats.errors[0].line == 8,
+          "loadIntegers reports the malformed lines");
+    filesystem::remove(path);
+}
+
+/**
+ * @brief Main function that checks the library against std::sort and the
+ * file sorts and formats against the data written.
+ *
+ * Every policy sorts every distribution of the catalogue at sizes from 0
+ * to 10000, by std::less and std::greater, as int, unsigned, int64_t,
+ * int16_t, float, double, records sorted by a projected key and strings.
+ * Radix sorts of large ranges, parallelSort, tunedSort, externalSort,
+ * streamSort, MappedDataset, loadIntegers and loadTuningProfile follow.
+ * Temporary files go to the system temporary directory and are removed.
+ *
+ * @return int 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    testSort<int>("int", numericPolicies);
+    testSort<unsigned>("unsigned", numericPolicies);
+    testSort<int64_t>("int64_t", numericPolicies);
+    testSort<int16_t>("int16_t", numericPolicies);
+    testSort<float>("float", numericPolicies);
+    testSort<double>("double", numericPolicies);
+    testSort<Record>("Record", numericPolicies, &Record::key);
+    testSort<string>("string", genericPolicies);
+    testLargeRadixSort();
+    testParallelSort();
+    testTunedSort();
+
+    filesystem::path directory = filesystem::temp_directory_path() / "hqsort_tests";
+    filesystem::create_directories(directory);
+    testExternalSort(directory);
+    testStreamSort(directory);
+    testMappedDataset<int>(directory, "int");
+    testMappedDataset<uint64_t>(directory, "uint64_t");
+    testMappedDataset<double>(directory, "double");
+    testLoadIntegers(directory);
+    testTuningProfiles(directory);
+    filesystem::remove_all(directory);
+
+    cout << checks << " checks, " << failures << " failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#ifndef BENCHMARK_STATISTICS_HPP
+#define BENCHMARK_STATISTICS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/**
+ * Robust summary of a set of timing samples: the median, the 5th and
+ * 95th percentiles, and a 95% bootstrap confidence interval of the median.
+ */
+struct SampleSummary {
+    double median = 0;
+    double p5 = 0;
+    double p95 = 0;
+    double medianLow = 0;  // Lower end of the 95% interval of the median
+    double medianHigh = 0; // Upper end of the 95% interval of the median
+};
+
+/**
+ * The resamples every bootstrap draws.
+ */
+constexpr int kBootstrapResamples = 2000;
+
+/**
+ * Returns the q-quantile of sorted samples, interpolating linearly between
+ * the two nearest ranks.
+ *
+ * @param sorted The samples in ascending order, not empty
+ * @param q The quantile, from 0 to 1
+ * @return The quantile
+ */
+inline double quantile(const std::vector<double>& sorted, double q) {
+    double position = q * static_cast<double>(sorted.size() - 1);
+    std::size_t below = static_cast<std::size_t>(position);
+    std::size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (position - static_cast<double>(below)) * (sorted[above] - sorted[below]);
+}
+
+/**
+ * Returns the median of samples, reordering them.
+ */
+inline double median(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    return quantile(samples, 0.5);
+}
+
+/**
+ * Draws the bootstrap distribution of the median of samples: the medians
+ * of kBootstrapResamples resamples drawn with replacement. The generator
+ * has a fixed seed, so the same samples always give the same interval.
+ *
+ * @param samples The samples, not empty
+ * @return The resampled medians in ascending order
+ */
+inline std::vector<double> bootstrapMedians(const std::vector<double>& samples) {
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<std::size_t> pick(0, samples.size() - 1);
+    std::vector<double> medians(kBootstrapResamples);
+    std::vector<double> resample(samples.size());
+    for (double& resampledMedian : medians) {
+        for (double& value : resample) {
+            value = samples[pick(gen)];
+        }
+        resampledMedian = median(resample);
+    }
+    std::sort(medians.begin(), medians.end());
+    return medians;
+}
+
+/**
+ * Summarizes timing samples.
+ *
+ * @param samples The samples, not empty
+ * @return The median, percentiles and 95% interval of the median
+ */
+inline SampleSummary summarize(std::vector<double> samples) {
+    SampleSummary summary;
+    std::sort(samples.begin(), samples.end());
+    summary.median = quantile(samples, 0.5);
+    summary.p5 = quantile(samples, 0.05);
+    summary.p95 = quantile(samples, 0.95);
+
+    std::vector<double> medians = bootstrapMedians(samples);
+    summary.medianLow = quantile(medians, 0.025);
+    summary.medianHigh = quantile(medians, 0.975);
+    return summary;
+}
+
+/**
+ * Tests whether two sets of paired samples differ: sample i of both was
+ * taken on the same input. The 95% bootstrap interval of the median of
+ * the differences a[i] - b[i] has to exclude zero. Pairing removes the
+ * variation between inputs, which otherwise hides small differences.
+ *
+ * @param a The samples of one variant
+ * @param b The samples of the other, as many as a
+ * @return True if a and b differ significantly
+ */
+inline bool significantlyDifferent(const std::vector<double>& a, const std::vector<double>& b) {
+    std::vector<double> differences(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        differences[i] = a[i] - b[i];
+    }
+    if (differences.size() < 2) {
+        return false;
+    }
+    std::vector<double> medians = bootstrapMedians(differences);
+    return quantile(medians, 0.025) > 0 || quantile(medians, 0.975) < 0;
+}
+
+#endif // BENCHMARK_STATISTICS_HPP
@@ -0,0 +1,57 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../include/hqsort/stream_sort.hpp"
+
+using namespace std;
+
+/**
+ * @brief Sorts newline-separated integers from stdin to stdout, parsing,
+ * sorting and writing on separate threads, and reports the throughput on
+ * stderr.
+ *
+ * Usage: streamSort [--chunk N] [--threads N] < INPUT > OUTPUT
+ *
+ * Chunks of --chunk integers (1048576 by default) are sorted by --threads
+ * threads while the rest of the input is parsed, then merged into a
+ * buffered writer. Lines that are not integers are skipped and reported.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    hqsort::StreamSortOptions options;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--chunk" && i + 1 < argc) {
+            options.chunkElements = strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--threads" && i + 1 < argc) {
+            options.sortThreads = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            cerr << "Usage: " << argv[0] << " [--chunk N] [--threads N] < INPUT > OUTPUT" << endl;
+            return 1;
+        }
+    }
+
+    hqsort::StreamSortStats stats;
+    bool ok = hqsort::streamSort<hqsort::Proposed10>(stdin, stdout, options, stats);
+
+    for (const hqsort::ParseError& error : stats.errors) {
+        cerr << "stdin:" << error.line << ": not an integer: " << error.text << endl;
+    }
+    if (stats.malformedLines > stats.errors.size()) {
+        cerr << "stdin: " << stats.malformedLines - stats.errors.size() << " more malformed lines" << endl;
+    }
+    if (!ok) {
+        cerr << "Error reading stdin or writing stdout" << endl;
+        return 1;
+    }
+
+    double megabytes = static_cast<double>(stats.inputBytes) / 1e6;
+    cerr << "Sorted " << stats.elements << " integers in " << stats.chunks << " chunks" << endl;
+    cerr << fixed << setprecision(3) << "Time: " << stats.seconds << " s (input parsed after "
+         << stats.parseSeconds << " s), " << setprecision(1) << megabytes / stats.seconds << " MB/s" << endl;
+    return 0;
+}
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+#include "../include/hqsort/hqsort.hpp"
+#include "../include/hqsort/tuning.hpp"
+#include "generators.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * Policy whose cutoff the sweep sets before every run.
+ */
+template <class PartitionScheme, class LeafRoutine>
+struct SweepPolicy : hqsort::DefaultPolicy {
+    static inline std::ptrdiff_t insertionSortCutoff = 10;
+    using Partition = PartitionScheme;
+    using Leaf = LeafRoutine;
+};
+
+/**
+ * Sorts a vector with the given partition scheme, leaf routine and cutoff.
+ *
+ * @param data The vector to sort
+ * @param profile The settings to sort with
+ */
+template <class PartitionScheme>
+void sortWith(vector<int>& data, const hqsort::TuningProfile& profile) {
+    if (profile.leaf == hqsort::LeafKind::Network) {
+        using Policy = SweepPolicy<PartitionScheme, hqsort::SortingNetworkLeaf>;
+        Policy::insertionSortCutoff = profile.cutoff;
+        hqsort::sort<Policy>(data.begin(), data.end());
+    } else {
+        using Policy = SweepPolicy<PartitionScheme, hqsort::InsertionSortLeaf>;
+        Policy::insertionSortCutoff = profile.cutoff;
+        hqsort::sort<Policy>(data.begin(), data.end());
+    }
+}
+
+void sortWith(vector<int>& data, const hqsort::TuningProfile& profile) {
+    switch (profile.partition) {
+    case hqsort::PartitionKind::Block:
+        sortWith<hqsort::BlockPartition>(data, profile);
+        break;
+    case hqsort::PartitionKind::Simd:
+        sortWith<hqsort::SimdPartition>(data, profile);
+        break;
+    case hqsort::PartitionKind::ThreeWay:
+        sortWith<hqsort::ThreeWayPartition>(data, profile);
+        break;
+    case hqsort::PartitionKind::DualPivot:
+        sortWith<hqsort::DualPivotPartition>(data, profile);
+        break;
+    case hqsort::PartitionKind::Hoare:
+        sortWith<hqsort::HoarePartition>(data, profile);
+        break;
+    }
+}
+
+/**
+ * Formats a profile as "cutoff/partition/leaf".
+ *
+ * @param profile The profile to format
+ * @return The formatted profile
+ */
+string describe(const hqsort::TuningProfile& profile) {
+    return to_string(profile.cutoff) + "/" + hqsort::toString(profile.partition) + "/" + hqsort::toString(profile.leaf);
+}
+
+/**
+ * @brief Sweeps the leaf cutoff, and unless --cutoff-only is given the
+ * partition scheme and leaf routine, over the benchmark distributions, then
+ * writes the setting with the lowest total runtime as a tuning profile for
+ * hqsort::tunedSort.
+ *
+ * Usage: tuner [--cutoff-only] [--size N] [--distribution NAME] [--seed N] [--output PATH]
+ *
+ * The profile goes to hqsort.profile unless --output names another file.
+ * --distribution restricts the sweep to one distribution of the benchmark
+ * catalogue, for hosts whose data is known to resemble it; by default the
+ * sweep covers Uniform, Bimodal, Exponential, Normal, Reversed and
+ * Duplicates. The datasets are drawn from --seed (kDefaultSeed by
+ * default).
+ *
+ * The profile holds one setting for the host, since tunedSort cannot tell
+ * which distribution its input follows; the best setting for each
+ * distribution is recorded in the profile's comments. Every sorted output
+ * is checked, and the sweep fails if a setting leaves a dataset unsorted.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    bool cutoffOnly = false;
+    size_t size = 100000;
+    string distribution;
+    string outputPath = "hqsort.profile";
+    uint64_t seed = kDefaultSeed;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--cutoff-only") {
+            cutoffOnly = true;
+        } else if (argument == "--size" && i + 1 < argc) {
+            size = strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--distribution" && i + 1 < argc) {
+            distribution = argv[++i];
+        } else if (argument == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--cutoff-only] [--size N] [--distribution NAME] [--seed N] [--output PATH]" << endl;
+            return 1;
+        }
+    }
+
+    // Generate the datasets to tune against
+    vector<string> datasetNames;
+    vector<vector<int>> datasets;
+    vector<string> names = {"Uniform", "Bimodal", "Exponential", "Normal", "Reversed", "Duplicates"};
+    if (!distribution.empty()) {
+        names = {distribution};
+    }
+    for (const string& name : names) {
+        const Distribution* found = findDistribution(name);
+        if (found == nullptr) {
+            cerr << "Unknown distribution: " << name << endl;
+            return 1;
+        }
+        datasetNames.push_back(found->name);
+        datasets.push_back(found->generate(size, datasetSeed(seed, found->name, size, 0)));
+    }
+
+    // Build the settings to sweep
+    vector<std::ptrdiff_t> cutoffs = {4, 6, 8, 10, 12, 16, 24, 32, 48, 64, 96, 128};
+    vector<hqsort::PartitionKind> partitions = {hqsort::PartitionKind::Hoare};
+    vector<hqsort::LeafKind> leaves = {hqsort::LeafKind::Insertion};
+    if (!cutoffOnly) {
+        partitions = {hqsort::PartitionKind::Hoare, hqsort::PartitionKind::Block, hqsort::PartitionKind::Simd,
+                      hqsort::PartitionKind::ThreeWay, hqsort::PartitionKind::DualPivot};
+        leaves = {hqsort::LeafKind::Insertion, hqsort::LeafKind::Network};
+    }
+
+    const int iterations = 5; // Runs per setting and dataset; the fastest counts
+    hqsort::TuningProfile best;
+    long long bestTotal = -1;
+    vector<long long> bestPerDataset(datasets.size(), -1);
+    vector<hqsort::TuningProfile> bestProfilePerDataset(datasets.size());
+
+    cout << "Data Size: " << size << ", Seed: " << seed << endl;
+    for (hqsort::PartitionKind partition : partitions) {
+        for (hqsort::LeafKind leaf : leaves) {
+            for (std::ptrdiff_t cutoff : cutoffs) {
+                hqsort::TuningProfile profile;
+                profile.cutoff = cutoff;
+                profile.partition = partition;
+                profile.leaf = leaf;
+
+                long long total = 0;
+                cout << setw(20) << left << describe(profile) << right;
+                for (size_t j = 0; j < datasets.size(); ++j) {
+                    long long fastest = -1;
+                    for (int i = 0; i < iterations; ++i) {
+                        vector<int> data = datasets[j];
+
+                        auto startSorting = high_resolution_clock::now();
+                        sortWith(data, profile);
+                        auto stopSorting = high_resolution_clock::now();
+
+                        // A setting that does not sort must not win the sweep
+                        if (!is_sorted(data.begin(), data.end())) {
+                            cout << endl;
+                            cerr << describe(profile) << " left " << datasetNames[j] << " unsorted" << endl;
+                            return 1;
+                        }
+
+                        long long duration = duration_cast<nanoseconds>(stopSorting - startSorting).count();
+                        if (fastest < 0 || duration < fastest) {
+                            fastest = duration;
+                        }
+                    }
+
+                    total += fastest;
+                    if (bestPerDataset[j] < 0 || fastest < bestPerDataset[j]) {
+                        bestPerDataset[j] = fastest;
+                        bestProfilePerDataset[j] = profile;
+                    }
+                    cout << " " << datasetNames[j] << " " << setw(10) << fastest << " ns";
+                }
+                cout << endl;
+
+                if (bestTotal < 0 || total < bestTotal) {
+                    bestTotal = total;
+                    best = profile;
+                }
+            }
+        }
+    }
+
+    // Report the best setting for each dataset and overall
+    ostringstream summary;
+    summary << "hqsort tuning profile, data size " << size << "\n";
+    for (size_t j = 0; j < datasets.size(); ++j) {
+        summary << "best for " << datasetNames[j] << ": " << describe(bestProfilePerDataset[j])
+                << " (" << bestPerDataset[j] << " ns)\n";
+    }
+    summary << "best overall: " << describe(best) << " (" << bestTotal << " ns total)";
+    cout << "---------------------------------" << endl;
+    cout << summary.str() << endl;
+
+    if (!hqsort::saveTuningProfile(outputPath, best, summary.str())) {
+        cerr << "Error opening file for writing: " << outputPath << endl;
+        return 1;
+    }
+    cout << "Profile written to " << outputPath << endl;
+    return 0;
+}
@@ -4,81 +4,9 @@
 #include <random>
 #include <numeric>
 
-using namespace std;
-
-void manualSort(vector<int>& arr, int low, int high) {
-    int N = high - low + 1;
-    if (N <= 1) {
-        return;
-    } else if (N == 2) {
-        if (arr[low] > arr[high]) {
-            swap(arr[low], arr[high]);
-        }
-    } else if (N == 3) {
-        if (arr[low] > arr[high - 1]) {
-            swap(arr[low], arr[high - 1]);
-        }
-        if (arr[low] > arr[high]) {
-            swap(arr[low], arr[high]);
-        }
-        if (arr[high - 1] > arr[high]) {
-            swap(arr[high - 1], arr[high]);
-        }
-    }
-}
-
-int partition(vector<int>& arr, int low, int high, int pivot) {
-    int i = low - 1;
-    int j = high + 1;
-    while (true) {
-        while (arr[++i] < pivot);
-        while (arr[--j] > pivot);
-        if (i >= j) {
-            break;
-        }
-        swap(arr[i], arr[j]);
-    }
-    return j;
-}
-
-void insertionSort(vector<int>& arr, int low, int high) {
-    for (int i = low + 1; i <= high; i++) {
-        int key = arr[i];
-        int j = i - 1;
-        while (j >= low && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            j--;
-        }
-        arr[j + 1] = key;
-    }
-}
-
-int calculatePivot(vector<int>& arr, int low, int high) {
-    int mid = (low + high) / 2;
-    vector<int> leftSubarray(arr.begin() + low, arr.begin() + mid + 1);
-    vector<int> rightSubarray(arr.begin() + mid + 1, arr.begin() + high + 1);
-
-    double leftMean = accumulate(leftSubarray.begin(), leftSubarray.end(), 0.0) / leftSubarray.size();
-    double rightMean = accumulate(rightSubarray.begin(), rightSubarray.end(), 0.0) / rightSubarray.size();
+#include "../include/hqsort/hqsort.hpp"
 
-    int pivot = static_cast<int>((leftMean + rightMean) / 2);
-
-    return pivot;
-}
-
-void quickSort(vector<int>& arr, int low, int high) {
-    int N = high - low + 1;
-    if (N <= 3) {
-        manualSort(arr, low, high);
-    } else if (N <= 10) {
-        insertionSort(arr, low, high);
-    } else {
-        int pivot = calculatePivot(arr, low, high);
-        int q = partition(arr, low, high, pivot);
-        quickSort(arr, low, q);
-        quickSort(arr, q + 1, high);
-    }
-}
+using namespace std;
 
 int main() {
     random_device rd;
@@ -88,7 +16,7 @@ int main() {
     vector<int> data(10000);
     generate(data.begin(), data.end(), [&]() { return dis(gen); });
 
-    quickSort(data, 0, data.size() - 1);
+    hqsort::sort<hqsort::ProposedPolicy<10, hqsort::MeanOfHalvesPivot>>(data.begin(), data.end());
 
     cout << "Sorted array: ";
     for (int num : data) {
@@ -0,0 +1,326 @@
+#ifndef HQSORT_BINARY_DATASET_HPP
+#define HQSORT_BINARY_DATASET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "int_reader.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HQSORT_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define HQSORT_HAS_MMAP 0
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "hqsort binary datasets are mapped in place and need a little-endian host"
+#endif
+
+namespace hqsort {
+
+/**
+ * Element types a binary dataset can hold, as stored in its header.
+ */
+enum class DatasetType : std::uint16_t {
+    Int32 = 1,
+    Int64 = 2,
+    UInt32 = 3,
+    UInt64 = 4,
+    Float32 = 5,
+    Float64 = 6
+};
+
+/**
+ * The DatasetType of T, for the element types a dataset can hold.
+ */
+template <class T>
+constexpr DatasetType datasetTypeOf() {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                  "binary datasets hold integers or floating-point numbers");
+    if constexpr (std::is_floating_point_v<T>) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "binary datasets hold float or double");
+        return sizeof(T) == 4 ? DatasetType::Float32 : DatasetType::Float64;
+    } else if constexpr (std::is_signed_v<T>) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "binary datasets hold 32- or 64-bit integers");
+        return sizeof(T) == 4 ? DatasetType::Int32 : DatasetType::Int64;
+    } else {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "binary datasets hold 32- or 64-bit integers");
+        return sizeof(T) == 4 ? DatasetType::UInt32 : DatasetType::UInt64;
+    }
+}
+
+/**
+ * The 32-byte header of a binary dataset, followed directly by count raw
+ * little-endian values. The values start 32-byte aligned in a mapping.
+ *
+ * checksum is datasetChecksum() of the value bytes.
+ */
+struct DatasetHeader {
+    char magic[4] = {'H', 'Q', 'S', 'D'};
+    std::uint16_t version = 1;
+    DatasetType type = DatasetType::Int32;
+    std::uint64_t count = 0;
+    std::uint64_t checksum = 0;
+    std::uint64_t reserved = 0;
+};
+static_assert(sizeof(DatasetHeader) == 32, "the dataset header is 32 bytes on disk");
+
+namespace detail {
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t checksumRound(std::uint64_t lane, std::uint64_t word) {
+    return rotateLeft(lane + word * 0xC2B2AE3D27D4EB4Full, 31) * 0x9E3779B97F4A7C15ull;
+}
+
+} // namespace detail
+
+/**
+ * Checksums bytes in four independent lanes of 64-bit words, with the
+ * xxHash64 round, so it runs at several GB/s. The tail that does not fill
+ * a 32-byte stripe is folded in word by word and then byte by byte.
+ *
+ * @param data The bytes to checksum
+ * @param size The number of bytes
+ *
+ * @return The checksum
+ */
+inline std::uint64_t datasetChecksum(const void* data, std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t lanes[4] = {1, 2, 3, 4};
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i + 8 * lane, 8);
+            lanes[lane] = detail::checksumRound(lanes[lane], word);
+        }
+    }
+
+    std::uint64_t hash = detail::rotateLeft(lanes[0], 1) + detail::rotateLeft(lanes[1], 7) +
+                         detail::rotateLeft(lanes[2], 12) + detail::rotateLeft(lanes[3], 18) + size;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = detail::checksumRound(hash, word);
+    }
+    for (; i < size; ++i) {
+        hash = detail::checksumRound(hash, bytes[i]);
+    }
+    return hash ^ (hash >> 29);
+}
+
+/**
+ * Writes values as a binary dataset.
+ *
+ * @param path The file to write
+ * @param values The values to write
+ * @param count The number of values
+ *
+ * @return false if the file could not be written
+ */
+template <class T>
+bool writeBinaryDataset(const std::string& path, const T* values, std::size_t count) {
+    DatasetHeader header;
+    header.type = datasetTypeOf<T>();
+    header.count = count;
+    header.checksum = datasetChecksum(values, count * sizeof(T));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   (count == 0 || std::fwrite(values, sizeof(T), count, file) == count);
+    return std::fclose(file) == 0 && written;
+}
+
+/**
+ * A binary dataset opened for reading.
+ *
+ * Where the OS supports it the file is memory-mapped copy-on-write, so
+ * opening costs a few system calls whatever its size, and data() can be
+ * sorted in place without changing the file; only the pages the sort
+ * touches are read and copied. Elsewhere the file is read into memory.
+ */
+template <class T>
+class MappedDataset {
+public:
+    MappedDataset() = default;
+    MappedDataset(const MappedDataset&) = delete;
+    MappedDataset& operator=(const MappedDataset&) = delete;
+    ~MappedDataset() {
+        close();
+    }
+
+    /**
+     * Opens a dataset of T values.
+     *
+     * @param path The file to open
+     * @param verify Whether to check the checksum, which reads every value
+     *
+     * @return false if the file could not be opened, is not a dataset of T,
+     *         is truncated or fails the checksum; error() says which
+     */
+    bool open(const std::string& path, bool verify = false) {
+        close();
+#if HQSORT_HAS_MMAP
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return fail("cannot open " + path);
+        }
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(DatasetHeader)) {
+            ::close(descriptor);
+            return fail(path + " is not a binary dataset");
+        }
+        size_ = static_cast<std::size_t>(status.st_size);
+        void* mapping = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+        ::close(descriptor);
+        if (mapping == MAP_FAILED) {
+            size_ = 0;
+            return fail("cannot map " + path);
+        }
+        mapping_ = static_cast<unsigned char*>(mapping);
+#else
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return fail("cannot open " + path);
+        }
+        std::fseek(file, 0, SEEK_END);
+        long end = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (end < static_cast<long>(sizeof(DatasetHeader))) {
+            std::fclose(file);
+            return fail(path + " is not a binary dataset");
+        }
+        size_ = static_cast<std::size_t>(end);
+        // Allocated as doubles so the values after the header are aligned
+        copy_.reset(new double[(size_ + sizeof(double) - 1) / sizeof(double)]);
+        mapping_ = reinterpret_cast<unsigned char*>(copy_.get());
+        bool read = std::fread(mapping_, 1, size_, file) == size_;
+        std::fclose(file);
+        if (!read) {
+            return fail("cannot read " + path);
+        }
+#endif
+
+        std::memcpy(&header_, mapping_, sizeof(header_));
+        if (std::memcmp(header_.magic, "HQSD", 4) != 0 || header_.version != 1) {
+            return fail(path + " is not a binary dataset");
+        }
+        if (header_.type != datasetTypeOf<T>()) {
+            return fail(path + " holds a different element type");
+        }
+        if (header_.count > (size_ - sizeof(DatasetHeader)) / sizeof(T)) {
+            return fail(path + " is truncated");
+        }
+        if (verify && datasetChecksum(data(), header_.count * sizeof(T)) != header_.checksum) {
+            return fail(path + " fails its checksum");
+        }
+        return true;
+    }
+
+    /**
+     * Unmaps the dataset.
+     */
+    void close() {
+#if HQSORT_HAS_MMAP
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, size_);
+        }
+#else
+        copy_.reset();
+#endif
+        mapping_ = nullptr;
+        size_ = 0;
+        header_ = DatasetHeader();
+    }
+
+    T* data() {
+        return mapping_ == nullptr ? nullptr : reinterpret_cast<T*>(mapping_ + sizeof(DatasetHeader));
+    }
+    const T* data() const {
+        return mapping_ == nullptr ? nullptr : reinterpret_cast<const T*>(mapping_ + sizeof(DatasetHeader));
+    }
+    std::size_t size() const {
+        return mapping_ == nullptr ? 0 : static_cast<std::size_t>(header_.count);
+    }
+    T* begin() {
+        return data();
+    }
+    T* end() {
+        return data() + size();
+    }
+    const DatasetHeader& header() const {
+        return header_;
+    }
+
+    /**
+     * Copies the values into a vector with one memcpy.
+     */
+    std::vector<T> toVector() const {
+        std::vector<T> values(size());
+        if (!values.empty()) {
+            std::memcpy(values.data(), data(), values.size() * sizeof(T));
+        }
+        return values;
+    }
+
+    /**
+     * Describes why the last open() failed.
+     */
+    const std::string& error() const {
+        return error_;
+    }
+
+private:
+    bool fail(std::string message) {
+        close();
+        error_ = std::move(message);
+        return false;
+    }
+
+    unsigned char* mapping_ = nullptr;
+    std::size_t size_ = 0;
+    DatasetHeader header_;
+    std::string error_;
+#if !HQSORT_HAS_MMAP
+    std::unique_ptr<double[]> copy_;
+#endif
+};
+
+/**
+ * Converts a text file of newline-separated ints, such as the files in
+ * FINAL/DATASETS, into a binary dataset of Int32 values.
+ *
+ * @param textPath The text file to read
+ * @param binaryPath The binary dataset to write
+ * @param stats Receives the bytes read and the malformed lines, which are
+ *              left out of the dataset
+ *
+ * @return false if the text file could not be read or the dataset written
+ */
+inline bool convertTextDataset(const std::string& textPath, const std::string& binaryPath,
+                               IntegerLoadStats& stats) {
+    std::vector<int> values;
+    return loadIntegers(textPath, values, stats) &&
+           writeBinaryDataset(binaryPath, values.data(), values.size());
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_BINARY_DATASET_HPP
@@ -0,0 +1,126 @@
+#ifndef HQSORT_BLOCK_PARTITION_HPP
+#define HQSORT_BLOCK_PARTITION_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include "keys.hpp"
+#include "partition.hpp"
+
+namespace hqsort {
+
+/**
+ * Branchless block partition of a range around a pivot key, after
+ * Edelkamp and Weiss' BlockQuicksort.
+ *
+ * Instead of stopping a scan at every misplaced key, which mispredicts about
+ * half the time on random data, the keys of one block from each end are
+ * compared against the pivot and the offsets of the misplaced ones are
+ * written into a buffer unconditionally, advancing the buffer by the
+ * comparison result. The buffered elements are then swapped pairwise in a
+ * loop whose trip count does not depend on individual comparisons. Keys
+ * equal to the pivot count as misplaced on both sides, as in the Hoare
+ * scans. The last two blocks' worth of elements are finished with a plain
+ * bounded scan.
+ *
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param pivot The pivot key to partition around
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The split point, with the same contract as partition()
+ */
+template <class RandomIt, class Key, class Keys>
+RandomIt blockPartition(RandomIt first, RandomIt last, const Key& pivot,
+                        const Keys& keys) {
+    using std::iter_swap;
+    constexpr int kBlockSize = 64;
+
+    // Offsets of the misplaced elements in the current left and right blocks
+    std::uint8_t offsetsLeft[kBlockSize];
+    std::uint8_t offsetsRight[kBlockSize];
+    int startLeft = 0, countLeft = 0;
+    int startRight = 0, countRight = 0;
+
+    RandomIt left = first;
+    RandomIt right = last;
+    while (right - left > 2 * kBlockSize) {
+        // Buffer the left block's keys that are not below the pivot
+        if (countLeft == 0) {
+            startLeft = 0;
+            for (int i = 0; i < kBlockSize; ++i) {
+                offsetsLeft[countLeft] = static_cast<std::uint8_t>(i);
+                countLeft += !keys.less(keys.key(left[i]), pivot);
+            }
+        }
+
+        // Buffer the right block's keys that are not above the pivot
+        if (countRight == 0) {
+            startRight = 0;
+            for (int i = 0; i < kBlockSize; ++i) {
+                offsetsRight[countRight] = static_cast<std::uint8_t>(i);
+                countRight += !keys.less(pivot, keys.key(right[-1 - i]));
+            }
+        }
+
+        // Swap as many misplaced pairs as both buffers hold
+        int count = std::min(countLeft, countRight);
+        for (int k = 0; k < count; ++k) {
+            iter_swap(left + offsetsLeft[startLeft + k],
+                      right - 1 - offsetsRight[startRight + k]);
+        }
+        countLeft -= count;
+        countRight -= count;
+        startLeft += count;
+        startRight += count;
+
+        // Move past every block whose misplaced elements are all swapped
+        if (countLeft == 0) {
+            left += kBlockSize;
+        }
+        if (countRight == 0) {
+            right -= kBlockSize;
+        }
+    }
+
+    // Finish the remaining elements with bounded scans
+    while (true) {
+        while (left < right && keys.less(keys.key(*left), pivot)) {
+            ++left;
+        }
+        while (left < right && keys.less(pivot, keys.key(right[-1]))) {
+            --right;
+        }
+        if (right - left <= 1) {
+            break;
+        }
+        iter_swap(left, right - 1);
+        ++left;
+        --right;
+    }
+    RandomIt split = left;
+
+    // Keys equal to the pivot can all end up on one side; fall back to the
+    // Hoare partition, which always splits off at least one element
+    if (split == first || split == last) {
+        return partition(first, last, pivot, keys);
+    }
+    return split;
+}
+
+/**
+ * Partition policy running blockPartition.
+ */
+struct BlockPartition {
+    template <class RandomIt, class Key, class Keys>
+    static RandomIt partition(RandomIt first, RandomIt last, const Key& pivot,
+                              const Keys& keys) {
+        return blockPartition(first, last, pivot, keys);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_BLOCK_PARTITION_HPP
@@ -0,0 +1,194 @@
+#ifndef HQSORT_COUNTING_SORT_HPP
+#define HQSORT_COUNTING_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "keys.hpp"
+#include "radix_sort.hpp"
+#include "simd.hpp"
+
+namespace hqsort {
+
+/**
+ * Bounds on the keys of a range in the sort order: no key is ordered
+ * before first or after last. Partitioning around a pivot leaves the left
+ * side within [first, pivot] and the right side within [pivot, last], so
+ * the bounds of every subrange are known without scanning it.
+ */
+template <class Key>
+struct KeyBounds {
+    Key first;
+    Key last;
+};
+
+/**
+ * Stands in for KeyBounds when a sort does not track them.
+ */
+struct NoKeyBounds {};
+
+namespace detail {
+
+/**
+ * True when countingSort applies: integer elements of at most 32 bits that
+ * are their own keys, ordered by std::less or std::greater. Counting sort
+ * rebuilds the elements from their key counts, so a projection would lose
+ * the rest of each element.
+ */
+template <class RandomIt, class Keys>
+constexpr bool isCountingSortable =
+    isRadixSortable<RandomIt, Keys> &&
+    std::is_same_v<Keys, KeyCompare<typename CompareOf<Keys>::type, identity>> &&
+    std::is_same_v<typename std::iterator_traits<RandomIt>::value_type, KeyType<RandomIt, Keys>>;
+
+/**
+ * The largest histogram counting sort builds, sized to stay in a typical
+ * 256 KB L2 cache.
+ */
+constexpr std::size_t kCountingSortHistogramBytes = 256 * 1024;
+
+/**
+ * Returns true if counting sort beats partitioning for N keys within
+ * bounds: the span of the keys is at most N and its histogram of 32-bit
+ * counts fits kCountingSortHistogramBytes.
+ */
+template <int Order, class Key>
+bool countingSortPays(std::ptrdiff_t N, const KeyBounds<Key>& bounds) {
+    std::uint32_t span = radixKey<Order>(bounds.last) - radixKey<Order>(bounds.first);
+    return static_cast<std::ptrdiff_t>(span) < N &&
+           (std::size_t(span) + 1) * sizeof(std::uint32_t) <= kCountingSortHistogramBytes;
+}
+
+/**
+ * Sorts N keys within bounds by counting every key and writing each one
+ * back as many times as it was seen. The histogram is kept per thread and
+ * reused.
+ */
+template <int Order, class RandomIt, class Key>
+void countingSortRange(RandomIt first, RandomIt last, const KeyBounds<Key>& bounds) {
+    std::uint32_t low = radixKey<Order>(bounds.first);
+    std::uint32_t span = radixKey<Order>(bounds.last) - low;
+
+    static thread_local std::vector<std::uint32_t> counts;
+    counts.assign(std::size_t(span) + 1, 0);
+    for (RandomIt i = first; i != last; ++i) {
+        ++counts[radixKey<Order>(*i) - low];
+    }
+
+    // Key k of the sort order is bounds.first stepped k times towards bounds.last
+    RandomIt out = first;
+    Key key = bounds.first;
+    for (std::uint32_t k = 0; k <= span; ++k) {
+        out = std::fill_n(out, counts[k], key);
+        if (k != span) {
+            key = Order > 0 ? static_cast<Key>(key + 1) : static_cast<Key>(key - 1);
+        }
+    }
+}
+
+#if HQSORT_HAS_X86_SIMD
+
+/**
+ * Finds the smallest and largest of n >= 1 ints with AVX2, eight lanes at
+ * a time.
+ */
+__attribute__((target("avx2"))) inline std::pair<int, int> minMaxIntsAvx2(const int* data,
+                                                                          std::ptrdiff_t n) {
+    std::ptrdiff_t i = 0;
+    int minimum = data[0];
+    int maximum = data[0];
+    if (n >= 8) {
+        __m256i minimums = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i maximums = minimums;
+        for (i = 8; i + 8 <= n; i += 8) {
+            __m256i keys = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            minimums = _mm256_min_epi32(minimums, keys);
+            maximums = _mm256_max_epi32(maximums, keys);
+        }
+        alignas(32) int lanes[2][8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), minimums);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), maximums);
+        for (int lane = 0; lane < 8; ++lane) {
+            minimum = std::min(minimum, lanes[0][lane]);
+            maximum = std::max(maximum, lanes[1][lane]);
+        }
+    }
+    for (; i < n; ++i) {
+        minimum = std::min(minimum, data[i]);
+        maximum = std::max(maximum, data[i]);
+    }
+    return {minimum, maximum};
+}
+
+#endif // HQSORT_HAS_X86_SIMD
+
+/**
+ * Finds the bounds of a non-empty range in the sort order, with AVX2 for
+ * contiguous ints when the CPU supports it.
+ */
+template <class RandomIt, class Keys>
+KeyBounds<KeyType<RandomIt, Keys>> findKeyBounds(RandomIt first, RandomIt last,
+                                                 const Keys& keys) {
+    using Key = KeyType<RandomIt, Keys>;
+    constexpr int Order = radixOrder<RandomIt, Keys>();
+
+    Key minimum = keys.key(*first);
+    Key maximum = minimum;
+#if HQSORT_HAS_X86_SIMD
+    if constexpr (std::is_same_v<RandomIt, int*> ||
+                  std::is_same_v<RandomIt, std::vector<int>::iterator>) {
+        if (simdLevel() != SimdLevel::Scalar) {
+            std::tie(minimum, maximum) = minMaxIntsAvx2(&*first, last - first);
+            return Order > 0 ? KeyBounds<Key>{minimum, maximum} : KeyBounds<Key>{maximum, minimum};
+        }
+    }
+#endif
+    for (RandomIt i = first + 1; i != last; ++i) {
+        minimum = std::min<Key>(minimum, keys.key(*i));
+        maximum = std::max<Key>(maximum, keys.key(*i));
+    }
+    return Order > 0 ? KeyBounds<Key>{minimum, maximum} : KeyBounds<Key>{maximum, minimum};
+}
+
+} // namespace detail
+
+/**
+ * Sorts a range of integers by counting them, in O(n + k) time for k
+ * distinct possible keys and with no comparisons, when k is at most n and
+ * the histogram fits in L2. One min/max scan (AVX2 for ints) decides.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return true if the range was sorted; false if counting sort does not
+ *         apply to the element type or comparator, or the key range is too
+ *         wide
+ */
+template <class RandomIt, class Keys>
+bool countingSort(RandomIt first, RandomIt last, const Keys& keys) {
+    if constexpr (!detail::isCountingSortable<RandomIt, Keys>) {
+        return false;
+    } else {
+        constexpr int Order = detail::radixOrder<RandomIt, Keys>();
+        if (first == last) {
+            return true;
+        }
+
+        auto bounds = detail::findKeyBounds(first, last, keys);
+        if (!detail::countingSortPays<Order>(last - first, bounds)) {
+            return false;
+        }
+        detail::countingSortRange<Order>(first, last, bounds);
+        return true;
+    }
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_COUNTING_SORT_HPP
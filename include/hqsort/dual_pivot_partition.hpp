@@ -0,0 +1,125 @@
+#ifndef HQSORT_DUAL_PIVOT_PARTITION_HPP
+#define HQSORT_DUAL_PIVOT_PARTITION_HPP
+
+#include <iterator>
+#include <utility>
+
+#include "keys.hpp"
+
+namespace hqsort {
+
+/**
+ * The result of a dual-pivot partition: the final places of the two pivot
+ * elements and their keys. Keys in [first, lowPivot) are ordered before
+ * low, keys in (lowPivot, highPivot) lie between low and high inclusive,
+ * and keys in (highPivot, last) are ordered after high.
+ */
+template <class RandomIt, class Key>
+struct DualPivotSplit {
+    RandomIt lowPivot;
+    RandomIt highPivot;
+    Key low;
+    Key high;
+};
+
+namespace detail {
+
+/**
+ * Sorts the elements at five positions by key with an insertion sort.
+ */
+template <class RandomIt, class Keys>
+void sortFive(RandomIt (&at)[5], const Keys& keys) {
+    using std::iter_swap;
+    for (int i = 1; i < 5; ++i) {
+        for (int j = i; j > 0 && keys.less(keys.key(*at[j]), keys.key(*at[j - 1])); --j) {
+            iter_swap(at[j], at[j - 1]);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Yaroslavskiy's dual-pivot partition of a range of at least 2 elements, as
+ * in the JDK: one pass splits the range into three parts around two
+ * pivots, so each level of the sort moves every element once while
+ * shrinking the parts to about a third.
+ *
+ * The pivots are the second and fourth of five keys spread over the middle
+ * of the range (the first and last keys for ranges below 7 elements), and
+ * end up in their final places between the parts.
+ *
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The places and keys of the two pivots
+ */
+template <class RandomIt, class Keys>
+DualPivotSplit<RandomIt, KeyType<RandomIt, Keys>> dualPivotPartition(RandomIt first, RandomIt last,
+                                                                     const Keys& keys) {
+    using std::iter_swap;
+    using Key = KeyType<RandomIt, Keys>;
+
+    // Move the pivots to the ends of the range, the lower one first
+    auto N = last - first;
+    if (N >= 7) {
+        auto step = N / 7;
+        RandomIt mid = first + N / 2;
+        RandomIt samples[5] = {mid - 2 * step, mid - step, mid, mid + step, mid + 2 * step};
+        detail::sortFive(samples, keys);
+        iter_swap(first, samples[1]);
+        iter_swap(last - 1, samples[3]);
+    } else if (keys.less(keys.key(last[-1]), keys.key(*first))) {
+        iter_swap(first, last - 1);
+    }
+    Key low = keys.key(*first);
+    Key high = keys.key(last[-1]);
+
+    // [first + 1, less) is below low, [less, k) between the pivots,
+    // (great, last - 1) above high, and [k, great] not yet seen
+    RandomIt less = first + 1;
+    RandomIt great = last - 2;
+    for (RandomIt k = less; k <= great; ++k) {
+        if (keys.less(keys.key(*k), low)) {
+            iter_swap(k, less);
+            ++less;
+        } else if (keys.less(high, keys.key(*k))) {
+            while (k < great && keys.less(high, keys.key(*great))) {
+                --great;
+            }
+            iter_swap(k, great);
+            --great;
+            if (keys.less(keys.key(*k), low)) {
+                iter_swap(k, less);
+                ++less;
+            }
+        }
+    }
+
+    // Put the pivots between the parts
+    --less;
+    ++great;
+    iter_swap(first, less);
+    iter_swap(last - 1, great);
+    return {less, great, low, high};
+}
+
+/**
+ * Partition policy running dualPivotPartition. It picks its own two
+ * pivots, so quickSort does not consult the policy's Pivot rule for it,
+ * and it skips the middle part when both pivots are equal.
+ */
+struct DualPivotPartition {
+    static constexpr bool dualPivot = true;
+
+    template <class RandomIt, class Keys>
+    static DualPivotSplit<RandomIt, KeyType<RandomIt, Keys>> partition(RandomIt first, RandomIt last,
+                                                                       const Keys& keys) {
+        return dualPivotPartition(first, last, keys);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_DUAL_PIVOT_PARTITION_HPP
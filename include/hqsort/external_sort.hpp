@@ -0,0 +1,454 @@
+#ifndef HQSORT_EXTERNAL_SORT_HPP
+#define HQSORT_EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "int_reader.hpp"
+#include "keys.hpp"
+#include "policy.hpp"
+#include "quicksort.hpp"
+
+namespace hqsort {
+
+/**
+ * Settings of externalSort.
+ *
+ * memoryBudget bounds the bytes of integers sorted in memory at once, and
+ * so the size of each spilled run; the merge splits the same budget between
+ * the read buffers of the runs it merges. At most fanIn runs are merged at
+ * once; more runs are merged in several passes. Runs are spilled to
+ * tempDirectory, or the system temporary directory if it is empty.
+ */
+struct ExternalSortOptions {
+    std::size_t memoryBudget = std::size_t(256) << 20;
+    std::size_t fanIn = 128;
+    std::string tempDirectory;
+};
+
+/**
+ * What an externalSort call did, for throughput reports.
+ */
+struct ExternalSortStats {
+    std::size_t elements = 0;
+    std::size_t runs = 0;
+    std::size_t mergePasses = 0;
+    std::size_t malformedLines = 0;
+    std::vector<ParseError> errors; // The first IntegerReader::kReportedErrors
+    std::uintmax_t inputBytes = 0;
+    std::uintmax_t outputBytes = 0;
+    double seconds = 0;
+};
+
+namespace detail {
+
+/**
+ * A stdio file closed when it goes out of scope.
+ */
+struct FileCloser {
+    void operator()(std::FILE* file) const {
+        std::fclose(file);
+    }
+};
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+/**
+ * Closes a file written to, so that late write errors are not lost.
+ *
+ * @return false if the file could not be flushed
+ */
+inline bool closeFile(File& file) {
+    return std::fclose(file.release()) == 0;
+}
+
+/**
+ * A spilled run of raw ints, removed from disk when it goes out of scope.
+ */
+class RunFile {
+public:
+    explicit RunFile(std::filesystem::path path) : path_(std::move(path)) {}
+    RunFile(RunFile&& other) noexcept : path_(std::move(other.path_)) {
+        other.path_.clear();
+    }
+    RunFile(const RunFile&) = delete;
+    RunFile& operator=(const RunFile&) = delete;
+    RunFile& operator=(RunFile&&) = delete;
+    ~RunFile() {
+        if (!path_.empty()) {
+            std::error_code ignored;
+            std::filesystem::remove(path_, ignored);
+        }
+    }
+
+    const std::filesystem::path& path() const {
+        return path_;
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+/**
+ * Streams the ints of a run through a buffer of its own. A read error or a
+ * run that ends inside an int ends the run early and clears good().
+ */
+class RunReader {
+public:
+    RunReader(const std::filesystem::path& path, std::size_t bufferElements)
+        : file_(std::fopen(path.string().c_str(), "rb")), buffer_(std::max<std::size_t>(bufferElements, 1)) {
+        refill();
+    }
+
+    bool good() const {
+        return file_ != nullptr && !failed_;
+    }
+    bool empty() const {
+        return position_ == size_;
+    }
+    int front() const {
+        return buffer_[position_];
+    }
+    void pop() {
+        if (++position_ == size_) {
+            refill();
+        }
+    }
+
+private:
+    void refill() {
+        position_ = 0;
+        size_ = 0;
+        if (!file_ || failed_) {
+            return;
+        }
+        std::size_t bytes = std::fread(buffer_.data(), 1, buffer_.size() * sizeof(int), file_.get());
+        failed_ = std::ferror(file_.get()) != 0 || bytes % sizeof(int) != 0;
+        size_ = failed_ ? 0 : bytes / sizeof(int);
+    }
+
+    File file_;
+    std::vector<int> buffer_;
+    std::size_t position_ = 0;
+    std::size_t size_ = 0;
+    bool failed_ = false;
+};
+
+/**
+ * Collects the output of the merge in a buffer and writes it with one
+ * large fwrite at a time, either as raw ints or as decimal text lines.
+ */
+class RunWriter {
+public:
+    RunWriter(std::FILE* file, std::size_t bufferBytes, bool text)
+        : file_(file), buffer_(std::max<std::size_t>(bufferBytes, 64)), text_(text) {}
+
+    void push(int value) {
+        if (buffer_.size() - used_ < 16) {
+            flush();
+        }
+        if (text_) {
+            char* end = std::to_chars(buffer_.data() + used_, buffer_.data() + buffer_.size(), value).ptr;
+            *end++ = '\n';
+            used_ = static_cast<std::size_t>(end - buffer_.data());
+        } else {
+            std::copy_n(reinterpret_cast<const char*>(&value), sizeof(int), buffer_.data() + used_);
+            used_ += sizeof(int);
+        }
+    }
+
+    /**
+     * Writes out the buffered data.
+     *
+     * @return false if the file could not be written
+     */
+    bool flush() {
+        if (used_ != 0) {
+            failed_ |= std::fwrite(buffer_.data(), 1, used_, file_) != used_;
+            written_ += used_;
+            used_ = 0;
+        }
+        return !failed_;
+    }
+
+    std::uintmax_t written() const {
+        return written_;
+    }
+
+private:
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::uintmax_t written_ = 0;
+    bool text_;
+    bool failed_ = false;
+};
+
+/**
+ * A tree of losers over k sorted sources: each internal node keeps the
+ * source that lost the match played there, and node 0 the overall winner.
+ * Replacing the winner's key replays only its path to the root, log2(k)
+ * comparisons against stored losers, with no sibling reloads as in a heap.
+ *
+ * A Source has empty(), front() and pop(), like RunReader.
+ */
+template <class Keys, class Source = RunReader>
+class LoserTree {
+public:
+    LoserTree(std::vector<Source>& sources, const Keys& keys)
+        : sources_(sources), keys_(keys), tree_(std::max<std::size_t>(sources.size(), 1)) {
+        tree_[0] = sources_.size() == 1 ? 0 : initialize(1);
+    }
+
+    /**
+     * Returns the source holding the smallest key, which is empty once
+     * every source is.
+     */
+    Source& winner() {
+        return sources_[tree_[0]];
+    }
+
+    /**
+     * Replays the matches of the winner after its key changed.
+     */
+    void replay() {
+        std::size_t k = sources_.size();
+        std::size_t winner = tree_[0];
+        for (std::size_t node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (beats(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+private:
+    bool beats(std::size_t a, std::size_t b) const {
+        if (sources_[a].empty()) {
+            return false;
+        }
+        return sources_[b].empty() || !keys_(sources_[b].front(), sources_[a].front());
+    }
+
+    // Leaves are nodes k to 2k - 1; returns the winner below node
+    std::size_t initialize(std::size_t node) {
+        std::size_t k = sources_.size();
+        if (node >= k) {
+            return node - k;
+        }
+        std::size_t left = initialize(2 * node);
+        std::size_t right = initialize(2 * node + 1);
+        if (beats(left, right)) {
+            tree_[node] = right;
+            return left;
+        }
+        tree_[node] = left;
+        return right;
+    }
+
+    std::vector<Source>& sources_;
+    const Keys& keys_;
+    std::vector<std::size_t> tree_;
+};
+
+/**
+ * Merges sorted runs into one output with a loser tree.
+ *
+ * @param runs The runs to merge
+ * @param output The file to write to
+ * @param text Whether to write decimal text lines instead of raw ints
+ * @param memoryBudget The bytes to split between the read and write buffers
+ * @param keys The comparator to order the ints by
+ * @param written Receives the number of bytes written
+ * @param elements Receives the number of ints merged
+ *
+ * @return false if a run could not be opened or read to its end, or the
+ *         output could not be written
+ */
+template <class Keys>
+bool mergeRuns(const std::vector<RunFile>& runs, std::FILE* output, bool text,
+               std::size_t memoryBudget, const Keys& keys, std::uintmax_t& written,
+               std::size_t& elements) {
+    std::size_t bufferBytes = std::max<std::size_t>(memoryBudget / (runs.size() + 1), std::size_t(1) << 16);
+
+    std::vector<RunReader> sources;
+    sources.reserve(runs.size());
+    for (const RunFile& run : runs) {
+        sources.emplace_back(run.path(), bufferBytes / sizeof(int));
+        if (!sources.back().good()) {
+            return false;
+        }
+    }
+
+    LoserTree<Keys> tree(sources, keys);
+    RunWriter writer(output, bufferBytes, text);
+    elements = 0;
+    for (RunReader* source = &tree.winner(); !source->empty(); source = &tree.winner()) {
+        writer.push(source->front());
+        source->pop();
+        tree.replay();
+        ++elements;
+    }
+    bool flushed = writer.flush();
+    written = writer.written();
+
+    // A run that failed looks empty to the merge; its remaining ints are
+    // missing from the output
+    for (const RunReader& source : sources) {
+        if (!source.good()) {
+            return false;
+        }
+    }
+    return flushed;
+}
+
+/**
+ * Returns a fresh path for a spilled run in directory.
+ */
+inline std::filesystem::path runPath(const std::filesystem::path& directory, std::size_t index) {
+    static thread_local std::mt19937_64 names(std::random_device{}());
+    return directory / ("hqsort-run-" + std::to_string(names()) + "-" + std::to_string(index) + ".tmp");
+}
+
+} // namespace detail
+
+/**
+ * Sorts a text file of newline-separated ints that may not fit in memory.
+ *
+ * The input is parsed by IntegerReader in chunks of at most
+ * options.memoryBudget bytes of ints; malformed lines are skipped and
+ * reported in stats. Each chunk is sorted with the proposed quicksort and
+ * spilled as a run of raw ints to a temporary file. The runs are then
+ * merged with a loser tree through large sequential buffers, options.fanIn
+ * at a time, and the result is written as text. Input that fits in one chunk is
+ * written straight from memory. Temporary files are removed before
+ * returning.
+ *
+ * @param inputPath The file to sort
+ * @param outputPath The file to write the sorted ints to, one per line
+ * @param options The memory budget, merge fan-in and temporary directory
+ * @param stats Receives counts and timings of the sort
+ * @param comp The strict weak ordering of the ints
+ *
+ * @return false if the input could not be read, a run could not be
+ *         written or read back, or the output has fewer ints than the input
+ */
+template <class Policy = DefaultPolicy, class Compare = std::less<>>
+bool externalSort(const std::string& inputPath, const std::string& outputPath,
+                  const ExternalSortOptions& options, ExternalSortStats& stats,
+                  Compare comp = {}) {
+    auto start = std::chrono::steady_clock::now();
+    stats = ExternalSortStats();
+    KeyCompare<Compare, identity> keys{comp, {}};
+
+    IntegerReader input(inputPath);
+    if (!input.is_open()) {
+        return false;
+    }
+    std::error_code error;
+
+    std::filesystem::path directory = options.tempDirectory;
+    if (directory.empty()) {
+        directory = std::filesystem::temp_directory_path(error);
+        if (error) {
+            return false;
+        }
+    }
+
+    // Sort chunks that fit the budget and spill them as runs
+    std::size_t chunkCapacity = std::max<std::size_t>(options.memoryBudget / sizeof(int), 1);
+    std::unique_ptr<int[]> chunk(new int[chunkCapacity]);
+    std::vector<detail::RunFile> runs;
+    bool finished = false;
+    while (!finished) {
+        std::size_t chunkSize = input.read(chunk.get(), chunkCapacity);
+        if (input.failed()) {
+            return false;
+        }
+        finished = input.eof();
+        stats.inputBytes = input.bytesRead();
+        stats.malformedLines = input.malformedLines();
+        stats.errors = input.errors();
+        quickSort<Policy>(chunk.get(), chunk.get() + chunkSize, keys);
+        stats.elements += chunkSize;
+
+        // Input that fits in one chunk needs no runs
+        if (finished && runs.empty()) {
+            detail::File output(std::fopen(outputPath.c_str(), "wb"));
+            if (!output) {
+                return false;
+            }
+            detail::RunWriter writer(output.get(), std::size_t(1) << 20, true);
+            for (std::size_t i = 0; i < chunkSize; ++i) {
+                writer.push(chunk[i]);
+            }
+            if (!writer.flush() || !detail::closeFile(output)) {
+                return false;
+            }
+            stats.outputBytes = writer.written();
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return true;
+        }
+
+        if (chunkSize != 0) {
+            runs.emplace_back(detail::runPath(directory, runs.size()));
+            detail::File run(std::fopen(runs.back().path().string().c_str(), "wb"));
+            if (!run || std::fwrite(chunk.get(), sizeof(int), chunkSize, run.get()) != chunkSize ||
+                !detail::closeFile(run)) {
+                return false;
+            }
+        }
+    }
+    stats.runs = runs.size();
+    chunk.reset();
+
+    // Merge the runs fanIn at a time until one merge can finish the job
+    std::size_t fanIn = std::max<std::size_t>(options.fanIn, 2);
+    while (runs.size() > fanIn) {
+        std::vector<detail::RunFile> merged;
+        for (std::size_t begin = 0; begin < runs.size(); begin += fanIn) {
+            std::size_t end = std::min(begin + fanIn, runs.size());
+            std::vector<detail::RunFile> group;
+            for (std::size_t i = begin; i < end; ++i) {
+                group.push_back(std::move(runs[i]));
+            }
+            merged.emplace_back(detail::runPath(directory, runs.size() + merged.size()));
+            detail::File run(std::fopen(merged.back().path().string().c_str(), "wb"));
+            std::uintmax_t written = 0;
+            std::size_t elements = 0;
+            if (!run || !detail::mergeRuns(group, run.get(), false, options.memoryBudget, keys, written, elements) ||
+                !detail::closeFile(run)) {
+                return false;
+            }
+        }
+        runs = std::move(merged);
+        ++stats.mergePasses;
+    }
+
+    // Every int read must come out of the last merge
+    detail::File output(std::fopen(outputPath.c_str(), "wb"));
+    std::size_t merged = 0;
+    if (!output ||
+        !detail::mergeRuns(runs, output.get(), true, options.memoryBudget, keys, stats.outputBytes, merged) ||
+        !detail::closeFile(output) || merged != stats.elements) {
+        return false;
+    }
+    ++stats.mergePasses;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_EXTERNAL_SORT_HPP
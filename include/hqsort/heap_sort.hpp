@@ -0,0 +1,26 @@
+#ifndef HQSORT_HEAP_SORT_HPP
+#define HQSORT_HEAP_SORT_HPP
+
+#include <algorithm>
+
+#include "keys.hpp"
+
+namespace hqsort {
+
+/**
+ * Sorts a range with heapsort in guaranteed O(n log n) time, whatever the
+ * order of the input. The depth-limited quicksort falls back to it.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ */
+template <class RandomIt, class Keys>
+void heapSort(RandomIt first, RandomIt last, const Keys& keys) {
+    std::make_heap(first, last, keys);
+    std::sort_heap(first, last, keys);
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_HEAP_SORT_HPP
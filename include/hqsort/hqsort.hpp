@@ -0,0 +1,56 @@
+#ifndef HQSORT_HQSORT_HPP
+#define HQSORT_HQSORT_HPP
+
+/**
+ * hqsort: header-only modified quicksort with insertion sort leaves.
+ *
+ * Sorts any random-access range by a comparator and projection:
+ *
+ *     hqsort::sort(v.begin(), v.end());
+ *     hqsort::sort<hqsort::Proposed50>(v.begin(), v.end(), std::greater<>());
+ *     hqsort::sort(rows.begin(), rows.end(), {}, &Row::id);
+ *
+ * The policy (see policy.hpp) fixes the insertion sort threshold, pivot
+ * rule and partition scheme at compile time.
+ */
+
+#include <functional>
+
+#include "block_partition.hpp"
+#include "counting_sort.hpp"
+#include "dual_pivot_partition.hpp"
+#include "heap_sort.hpp"
+#include "keys.hpp"
+#include "leaf.hpp"
+#include "natural_runs.hpp"
+#include "operation_counts.hpp"
+#include "partition.hpp"
+#include "pivot.hpp"
+#include "policy.hpp"
+#include "quicksort.hpp"
+#include "radix_sort.hpp"
+#include "simd_partition.hpp"
+#include "sorting_network.hpp"
+#include "three_way_partition.hpp"
+
+namespace hqsort {
+
+/**
+ * Sorts [first, last) with the proposed quicksort.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param comp The strict weak ordering of keys
+ * @param proj The projection from an element to its key
+ */
+template <class Policy = DefaultPolicy, class RandomIt,
+          class Compare = std::less<>, class Projection = identity>
+void sort(RandomIt first, RandomIt last, Compare comp = {},
+          Projection proj = {}) {
+    KeyCompare<Compare, Projection> keys{comp, proj};
+    quickSort<Policy>(first, last, keys);
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_HQSORT_HPP
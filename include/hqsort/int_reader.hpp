@@ -0,0 +1,299 @@
+#ifndef HQSORT_INT_READER_HPP
+#define HQSORT_INT_READER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace hqsort {
+
+/**
+ * A line of an integer file that is not an int.
+ */
+struct ParseError {
+    std::size_t line = 0; // 1-based
+    std::string text;     // The start of the line
+};
+
+/**
+ * Reads newline-separated ints from a file in large blocks and parses them
+ * with a hand-written digit loop, which is several times faster than
+ * formatted stream extraction.
+ *
+ * Every line holds one int in decimal with an optional sign; spaces, tabs
+ * and a carriage return around it are allowed, and blank lines are
+ * skipped. Other lines, and numbers outside the range of int, are counted
+ * as malformed and skipped; the first kReportedErrors of them are kept
+ * with their line number for reporting.
+ */
+class IntegerReader {
+public:
+    static constexpr std::size_t kReportedErrors = 100;
+
+    /**
+     * Opens a file for reading.
+     *
+     * @param path The file to read
+     * @param blockSize The bytes to read from the file at once
+     */
+    explicit IntegerReader(const std::string& path, std::size_t blockSize = std::size_t(1) << 20)
+        : file_(std::fopen(path.c_str(), "rb")), buffer_(std::max<std::size_t>(blockSize, 64) + 1) {}
+
+    /**
+     * Reads from a file that is already open, such as stdin, and is left
+     * open.
+     *
+     * @param file The file to read
+     * @param blockSize The bytes to read from the file at once
+     */
+    explicit IntegerReader(std::FILE* file, std::size_t blockSize = std::size_t(1) << 20)
+        : file_(file), buffer_(std::max<std::size_t>(blockSize, 64) + 1), ownsFile_(false) {}
+
+    IntegerReader(const IntegerReader&) = delete;
+    IntegerReader& operator=(const IntegerReader&) = delete;
+    ~IntegerReader() {
+        if (file_ != nullptr && ownsFile_) {
+            std::fclose(file_);
+        }
+    }
+
+    bool is_open() const {
+        return file_ != nullptr;
+    }
+
+    /**
+     * Parses up to capacity ints into out.
+     *
+     * @return The number of ints parsed; less than capacity only at the end
+     *         of the file or on a read error
+     */
+    std::size_t read(int* out, std::size_t capacity) {
+        std::size_t count = 0;
+        while (count < capacity) {
+            if (cursor_ == parsedEnd_ && !fill()) {
+                break;
+            }
+            count += parse(out + count, capacity - count);
+        }
+        return count;
+    }
+
+    /**
+     * Returns true once the whole file has been parsed.
+     */
+    bool eof() const {
+        return atEnd_ && cursor_ == parsedEnd_;
+    }
+
+    /**
+     * Returns true if reading the file failed.
+     */
+    bool failed() const {
+        return failed_;
+    }
+
+    std::uintmax_t bytesRead() const {
+        return bytesRead_;
+    }
+    std::size_t malformedLines() const {
+        return malformedLines_;
+    }
+    const std::vector<ParseError>& errors() const {
+        return errors_;
+    }
+
+private:
+    // Moves the unparsed tail to the front of the buffer and reads another
+    // block behind it; only complete lines are exposed to parse()
+    bool fill() {
+        if (file_ == nullptr || atEnd_) {
+            return false;
+        }
+
+        std::size_t tail = static_cast<std::size_t>(end_ - cursor_);
+        std::memmove(buffer_.data(), cursor_, tail);
+        cursor_ = buffer_.data();
+        end_ = buffer_.data() + tail;
+
+        // A line longer than the buffer is malformed; drop it as it comes
+        std::size_t capacity = buffer_.size() - 1;
+        if (tail == capacity) {
+            if (!skippingLine_) {
+                ++lineNumber_;
+                reportMalformed(cursor_, end_);
+                skippingLine_ = true;
+            }
+            end_ = cursor_;
+            tail = 0;
+        }
+
+        std::size_t got = std::fread(end_, 1, capacity - tail, file_);
+        bytesRead_ += got;
+        end_ += got;
+        if (got < capacity - tail) {
+            failed_ = std::ferror(file_) != 0;
+            atEnd_ = true;
+            // Terminate a last line that has no newline
+            if (end_ != cursor_ && end_[-1] != '\n') {
+                *end_++ = '\n';
+            }
+        }
+
+        // Expose the complete lines
+        parsedEnd_ = end_;
+        while (parsedEnd_ != cursor_ && parsedEnd_[-1] != '\n') {
+            --parsedEnd_;
+        }
+        if (skippingLine_ && parsedEnd_ != cursor_) {
+            cursor_ = static_cast<char*>(std::memchr(cursor_, '\n', parsedEnd_ - cursor_)) + 1;
+            skippingLine_ = false;
+        }
+        return true;
+    }
+
+    // Parses complete lines from cursor_; every line ends with '\n' before
+    // parsedEnd_, which stops the scans without bounds checks
+    std::size_t parse(int* out, std::size_t capacity) {
+        std::size_t count = 0;
+        const char* p = cursor_;
+        while (count < capacity && p != parsedEnd_) {
+            const char* line = p;
+            ++lineNumber_;
+
+            // Read an optional sign and the digits, with spaces around them
+            while (*p == ' ' || *p == '\t') {
+                ++p;
+            }
+            const char* number = p;
+            bool negative = *p == '-';
+            if (*p == '-' || *p == '+') {
+                ++p;
+            }
+            // Leading zeros do not count against the digit limit below
+            const char* digits = p;
+            while (*p == '0') {
+                ++p;
+            }
+            const char* significant = p;
+            std::uint64_t value = 0;
+            while (static_cast<unsigned char>(*p - '0') < 10) {
+                value = value * 10 + static_cast<unsigned>(*p - '0');
+                ++p;
+            }
+            const char* numberEnd = p;
+            while (*p == ' ' || *p == '\t' || *p == '\r') {
+                ++p;
+            }
+
+            if (*p == '\n') {
+                // Up to 18 significant digits cannot overflow the
+                // accumulator; longer numbers are out of range anyway
+                if (numberEnd != digits && numberEnd - significant <= 18 &&
+                    value <= static_cast<std::uint64_t>(INT_MAX) + (negative ? 1 : 0)) {
+                    out[count++] = negative ? static_cast<int>(0 - value) : static_cast<int>(value);
+                    ++p;
+                    continue;
+                }
+                // Blank lines are skipped quietly
+                if (numberEnd == number) {
+                    ++p;
+                    continue;
+                }
+            }
+
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', parsedEnd_ - p));
+            reportMalformed(line, newline);
+            p = newline + 1;
+        }
+        cursor_ = const_cast<char*>(p);
+        return count;
+    }
+
+    void reportMalformed(const char* line, const char* end) {
+        ++malformedLines_;
+        if (errors_.size() < kReportedErrors) {
+            std::size_t length = std::min<std::size_t>(static_cast<std::size_t>(end - line), 64);
+            errors_.push_back({lineNumber_, std::string(line, length)});
+        }
+    }
+
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    char* cursor_ = buffer_.data();
+    char* parsedEnd_ = buffer_.data();
+    char* end_ = buffer_.data();
+    std::uintmax_t bytesRead_ = 0;
+    std::size_t lineNumber_ = 0;
+    std::size_t malformedLines_ = 0;
+    std::vector<ParseError> errors_;
+    bool atEnd_ = false;
+    bool failed_ = false;
+    bool skippingLine_ = false;
+    bool ownsFile_ = true;
+};
+
+/**
+ * What a loadIntegers call read, for throughput and error reports.
+ */
+struct IntegerLoadStats {
+    std::uintmax_t bytes = 0;
+    std::size_t malformedLines = 0;
+    std::vector<ParseError> errors; // The first IntegerReader::kReportedErrors
+    double seconds = 0;
+};
+
+/**
+ * Reads a whole file of newline-separated ints with IntegerReader.
+ * Malformed lines are skipped and reported in stats.
+ *
+ * @param path The file to read
+ * @param values Receives the ints in file order
+ * @param stats Receives the bytes read, the malformed lines and the time
+ *
+ * @return false if the file could not be opened or read
+ */
+inline bool loadIntegers(const std::string& path, std::vector<int>& values, IntegerLoadStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    stats = IntegerLoadStats();
+    values.clear();
+
+    // Size the block and the first guess at the count from the file size;
+    // typical lines take about 8 bytes
+    std::error_code error;
+    std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+    std::size_t blockSize = std::size_t(1) << 20;
+    if (!error && fileSize < blockSize) {
+        blockSize = static_cast<std::size_t>(fileSize) + 1;
+    }
+    IntegerReader reader(path, blockSize);
+    if (!reader.is_open()) {
+        return false;
+    }
+
+    // Grow geometrically, parsing straight into the vector's storage
+    std::size_t size = 0;
+    std::size_t guess = error ? 0 : static_cast<std::size_t>(fileSize / 8);
+    while (!reader.eof() && !reader.failed()) {
+        values.resize(std::max<std::size_t>({size * 2, guess, 1024}));
+        size += reader.read(values.data() + size, values.size() - size);
+    }
+    values.resize(size);
+
+    stats.bytes = reader.bytesRead();
+    stats.malformedLines = reader.malformedLines();
+    stats.errors = reader.errors();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return !reader.failed();
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_INT_READER_HPP
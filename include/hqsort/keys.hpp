@@ -0,0 +1,89 @@
+#ifndef HQSORT_KEYS_HPP
+#define HQSORT_KEYS_HPP
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hqsort {
+
+/**
+ * Projection that returns its argument unchanged, so elements are compared
+ * by their own value.
+ */
+struct identity {
+    template <class T>
+    constexpr T&& operator()(T&& value) const noexcept {
+        return std::forward<T>(value);
+    }
+};
+
+/**
+ * Bundles the comparator and projection passed to the sort so every stage
+ * (pivot, partition, leaf) compares keys the same way.
+ *
+ * The synthetic pivots of the proposed algorithm are computed from keys, not
+ * picked from the range, so partitioning compares elements against a key
+ * value. less() compares two keys; operator() compares two elements.
+ */
+template <class Compare, class Projection>
+struct KeyCompare {
+    Compare comp;
+    Projection proj;
+
+    /**
+     * Returns the sort key of an element.
+     *
+     * @param value The element to project
+     *
+     * @return The key the element is ordered by
+     */
+    template <class T>
+    constexpr decltype(auto) key(T&& value) const {
+        return std::invoke(proj, std::forward<T>(value));
+    }
+
+    /**
+     * Compares two keys.
+     *
+     * @param a The left key
+     * @param b The right key
+     *
+     * @return True if a is ordered before b
+     */
+    template <class A, class B>
+    constexpr bool less(const A& a, const B& b) const {
+        return std::invoke(comp, a, b);
+    }
+
+    /**
+     * Compares two elements by their keys.
+     *
+     * @param a The left element
+     * @param b The right element
+     *
+     * @return True if a is ordered before b
+     */
+    template <class A, class B>
+    constexpr bool operator()(const A& a, const B& b) const {
+        return less(key(a), key(b));
+    }
+};
+
+/**
+ * The decayed key type produced by projecting an element of RandomIt.
+ */
+template <class RandomIt, class Keys>
+using KeyType = std::decay_t<decltype(std::declval<const Keys&>().key(
+    *std::declval<RandomIt>()))>;
+
+/**
+ * The signed distance type of RandomIt.
+ */
+template <class RandomIt>
+using DifferenceType = typename std::iterator_traits<RandomIt>::difference_type;
+
+} // namespace hqsort
+
+#endif // HQSORT_KEYS_HPP
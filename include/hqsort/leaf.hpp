@@ -0,0 +1,105 @@
+#ifndef HQSORT_LEAF_HPP
+#define HQSORT_LEAF_HPP
+
+#include <iterator>
+#include <utility>
+
+#include "keys.hpp"
+#include "operation_counts.hpp"
+
+namespace hqsort {
+
+/**
+ * Sorts a range of at most 3 elements in-place with fixed compare-swaps.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ */
+template <class RandomIt, class Keys>
+void manualSort(RandomIt first, RandomIt last, const Keys& keys) {
+    using std::iter_swap;
+
+    // Calculate the number of elements in the range.
+    auto N = last - first;
+    countOperations(&OperationCounts::manualSortCalls);
+
+    // If the range has 1 or fewer elements, return early.
+    if (N <= 1) {
+        return;
+    }
+    // If the range has 2 elements, sort them if necessary.
+    else if (N == 2) {
+        countOperations(&OperationCounts::leafComparisons);
+        if (keys(first[1], first[0])) {
+            iter_swap(first, first + 1);
+            countOperations(&OperationCounts::swaps);
+        }
+    }
+    // If the range has 3 elements, sort them with three compare-swaps.
+    else if (N == 3) {
+        countOperations(&OperationCounts::leafComparisons, 3);
+        if (keys(first[1], first[0])) {
+            iter_swap(first, first + 1);
+            countOperations(&OperationCounts::swaps);
+        }
+        if (keys(first[2], first[0])) {
+            iter_swap(first, first + 2);
+            countOperations(&OperationCounts::swaps);
+        }
+        if (keys(first[2], first[1])) {
+            iter_swap(first + 1, first + 2);
+            countOperations(&OperationCounts::swaps);
+        }
+    }
+}
+
+/**
+ * Performs insertion sort on a range.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ */
+template <class RandomIt, class Keys>
+void insertionSort(RandomIt first, RandomIt last, const Keys& keys) {
+    if (first == last) {
+        return;
+    }
+    countOperations(&OperationCounts::insertionSortCalls);
+
+    // Iterate through the range starting from the second element
+    for (RandomIt i = first + 1; i != last; ++i) {
+        // Take the current element out as the value to insert
+        auto value = std::move(*i);
+        RandomIt j = i;
+
+        // Traverse backward and shift elements ordered after the value
+        while (j != first && keys(value, *(j - 1))) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+
+        // Place the value at its correct position
+        *j = std::move(value);
+
+        // One comparison per shift, plus the one that stopped the scan
+        // unless it reached the front; two moves besides the shifts
+        countOperations(&OperationCounts::leafComparisons, (i - j) + (j != first));
+        countOperations(&OperationCounts::moves, (i - j) + 2);
+    }
+}
+
+/**
+ * Leaf policy running insertionSort.
+ */
+struct InsertionSortLeaf {
+    template <class RandomIt, class Keys>
+    static void sort(RandomIt first, RandomIt last, const Keys& keys) {
+        insertionSort(first, last, keys);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_LEAF_HPP
@@ -0,0 +1,111 @@
+#ifndef HQSORT_NATURAL_RUNS_HPP
+#define HQSORT_NATURAL_RUNS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "keys.hpp"
+
+namespace hqsort {
+
+namespace detail {
+
+/**
+ * Finds the natural run starting at first: the longest non-descending
+ * prefix, or the longest non-ascending prefix, which is reversed in place.
+ *
+ * @return The end of the run, which is now non-descending
+ */
+template <class RandomIt, class Keys>
+RandomIt takeNaturalRun(RandomIt first, RandomIt last, const Keys& keys) {
+    RandomIt end = first + 1;
+    if (end == last) {
+        return end;
+    }
+
+    if (keys(*end, *first)) {
+        // Descending run: find its end and reverse it
+        while (end != last && !keys(*(end - 1), *end)) {
+            ++end;
+        }
+        std::reverse(first, end);
+    } else {
+        while (end != last && !keys(*end, *(end - 1))) {
+            ++end;
+        }
+    }
+    return end;
+}
+
+} // namespace detail
+
+/**
+ * Sorts a range that is already made of a few long natural runs, and
+ * leaves other ranges to the caller.
+ *
+ * One scan splits the range into maximal non-descending and non-ascending
+ * runs, reversing the latter in place. A sorted or reversed range is then
+ * done in O(n) time without allocating. A range of at most
+ * n / minimumAverageRun runs is finished by merging neighbouring runs
+ * (std::inplace_merge), in O(n log r) for r runs. That path is not in
+ * place: it keeps the run ends, and each merge allocates a temporary
+ * buffer of up to n elements. If the buffer cannot be allocated,
+ * std::inplace_merge merges without one, and the merges take
+ * O(n log n log r) time, at worst O(n log^2 n). The scan stops as soon as
+ * the range has more runs than the limit, so it costs little on unordered
+ * input.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ * @param minimumAverageRun The shortest average run length worth merging
+ *
+ * @return true if the range is now sorted; false if it has too many runs,
+ *         in which case it is still a permutation of the input
+ */
+template <class RandomIt, class Keys>
+bool mergeNaturalRuns(RandomIt first, RandomIt last, const Keys& keys,
+                      std::ptrdiff_t minimumAverageRun = 32) {
+    auto N = last - first;
+    if (N <= 1) {
+        return true;
+    }
+
+    // A single run means the range was sorted or reversed
+    RandomIt runEnd = detail::takeNaturalRun(first, last, keys);
+    if (runEnd == last) {
+        return true;
+    }
+
+    // Find the remaining runs, giving up once there are too many
+    std::size_t maxRuns = static_cast<std::size_t>(std::max<std::ptrdiff_t>(N / minimumAverageRun, 1));
+    std::vector<std::ptrdiff_t> runEnds = {runEnd - first};
+    while (runEnd != last) {
+        if (runEnds.size() == maxRuns) {
+            return false;
+        }
+        runEnd = detail::takeNaturalRun(runEnd, last, keys);
+        runEnds.push_back(runEnd - first);
+    }
+
+    // Merge neighbouring runs until one is left
+    while (runEnds.size() > 1) {
+        std::size_t merged = 0;
+        std::ptrdiff_t start = 0;
+        for (std::size_t i = 0; i + 1 < runEnds.size(); i += 2) {
+            std::inplace_merge(first + start, first + runEnds[i], first + runEnds[i + 1], keys);
+            start = runEnds[i + 1];
+            runEnds[merged++] = runEnds[i + 1];
+        }
+        if (runEnds.size() % 2 == 1) {
+            runEnds[merged++] = runEnds.back();
+        }
+        runEnds.resize(merged);
+    }
+    return true;
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_NATURAL_RUNS_HPP
@@ -0,0 +1,130 @@
+#ifndef HQSORT_OPERATION_COUNTS_HPP
+#define HQSORT_OPERATION_COUNTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Define HQSORT_COUNT_OPERATIONS to 1, for the whole program, to build the
+ * sort with operation counting. Otherwise every counting call below is an
+ * empty inline function and the sort compiles to the same code as without
+ * them.
+ */
+#ifndef HQSORT_COUNT_OPERATIONS
+#define HQSORT_COUNT_OPERATIONS 0
+#endif
+
+namespace hqsort {
+
+/**
+ * The work a sort did, counted when HQSORT_COUNT_OPERATIONS is set.
+ *
+ * The Hoare partition, insertionSort and manualSort count their
+ * comparisons and element operations; the other partition schemes and
+ * leaf routines only count partitions and depth. Comparisons made by the
+ * pivot rule are not counted.
+ */
+struct OperationCounts {
+    std::uint64_t partitionComparisons = 0;
+    std::uint64_t leafComparisons = 0; // By insertionSort and manualSort
+    std::uint64_t swaps = 0;
+    std::uint64_t moves = 0; // Element moves outside swaps
+    std::uint64_t manualSortCalls = 0;
+    std::uint64_t insertionSortCalls = 0;
+    std::uint64_t partitions = 0;
+    double smallerSideSum = 0; // Sum of min(|left|, |right|) / n per partition
+    int maxDepth = 0;          // Deepest nesting of partitions
+};
+
+/**
+ * True if this build counts operations.
+ */
+constexpr bool countsOperations = HQSORT_COUNT_OPERATIONS != 0;
+
+namespace detail {
+
+struct OperationState {
+    OperationCounts counts;
+    int level = 0; // Partitions enclosing the range being sorted
+};
+
+inline OperationState& operationState() {
+    thread_local OperationState state;
+    return state;
+}
+
+} // namespace detail
+
+/**
+ * Returns the operations counted on the calling thread since the last
+ * resetOperationCounts(); parallelSort counts on its worker threads.
+ */
+inline const OperationCounts& operationCounts() {
+    return detail::operationState().counts;
+}
+
+/**
+ * Sets the counts of the calling thread to zero.
+ */
+inline void resetOperationCounts() {
+    detail::operationState().counts = OperationCounts();
+}
+
+/**
+ * Adds to one count, if this build counts operations.
+ *
+ * @param counter The count to add to, such as &OperationCounts::swaps
+ * @param count The number of operations
+ */
+inline void countOperations(std::uint64_t OperationCounts::*counter, std::uint64_t count = 1) {
+    if constexpr (countsOperations) {
+        detail::operationState().counts.*counter += count;
+    }
+}
+
+/**
+ * Counts a partition of a range and moves one level deeper: ranges sorted
+ * until the enclosing PartitionLevelScope ends are nested in it.
+ *
+ * @param size The size of the partitioned range
+ * @param smallerSide The size of its smaller side
+ */
+inline void countPartition(std::ptrdiff_t size, std::ptrdiff_t smallerSide) {
+    if constexpr (countsOperations) {
+        detail::OperationState& state = detail::operationState();
+        ++state.counts.partitions;
+        state.counts.smallerSideSum += static_cast<double>(smallerSide) / static_cast<double>(size);
+        state.counts.maxDepth = std::max(state.counts.maxDepth, ++state.level);
+    }
+}
+
+/**
+ * Restores the partition level on leaving a sort call, so a recursive call
+ * starts at the level of the partition that made its range. Since the
+ * sort loops on the larger side instead of recursing, the levels count
+ * the depth of the partitions, which would be the recursion depth of a
+ * sort recursing into both sides.
+ */
+class PartitionLevelScope {
+public:
+    PartitionLevelScope() {
+        if constexpr (countsOperations) {
+            level_ = detail::operationState().level;
+        }
+    }
+    PartitionLevelScope(const PartitionLevelScope&) = delete;
+    PartitionLevelScope& operator=(const PartitionLevelScope&) = delete;
+    ~PartitionLevelScope() {
+        if constexpr (countsOperations) {
+            detail::operationState().level = level_;
+        }
+    }
+
+private:
+    int level_ = 0;
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_OPERATION_COUNTS_HPP
@@ -0,0 +1,162 @@
+#ifndef HQSORT_PARALLEL_HPP
+#define HQSORT_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include "heap_sort.hpp"
+#include "keys.hpp"
+#include "natural_runs.hpp"
+#include "parallel_partition.hpp"
+#include "partition.hpp"
+#include "policy.hpp"
+#include "quicksort.hpp"
+#include "thread_pool.hpp"
+
+namespace hqsort {
+
+/**
+ * Settings of parallelSort.
+ *
+ * Ranges of at most grainSize elements are sorted sequentially by the
+ * proposed quickSort; larger ranges are partitioned and one side is handed
+ * to the pool. Ranges of more than parallelPartitionCutoff elements are
+ * themselves partitioned by all threads in blocks of partitionBlockSize.
+ */
+struct ParallelOptions {
+    unsigned threads = std::thread::hardware_concurrency();
+    std::ptrdiff_t grainSize = std::ptrdiff_t(1) << 14;
+    std::ptrdiff_t parallelPartitionCutoff = std::ptrdiff_t(1) << 20;
+    std::ptrdiff_t partitionBlockSize = std::ptrdiff_t(1) << 16;
+};
+
+namespace detail {
+
+/**
+ * Partitions ranges above the grain size, queuing the left side as a task
+ * and continuing with the right side, then sorts the rest sequentially.
+ *
+ * @param group The task group of this sort
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ * @param options The grain size and parallel partition settings
+ * @param depthBudget The partitioning levels left before heapsort takes over
+ */
+template <class Policy, class RandomIt, class Keys>
+void parallelQuickSort(TaskGroup& group, RandomIt first, RandomIt last,
+                       const Keys& keys, const ParallelOptions& options,
+                       int depthBudget) {
+    while (last - first > options.grainSize) {
+        // If the partitions have been too unbalanced for too long, use heapsort
+        if (Policy::depthLimited && depthBudget == 0) {
+            heapSort(first, last, keys);
+            return;
+        }
+        --depthBudget;
+
+        // Partition the range around the policy's pivot, using every thread
+        // while the range is too large for one. Dual-pivot schemes split in
+        // three, so the parallel levels use the Hoare partition for them.
+        auto pivot = Policy::Pivot::calculatePivot(first, last, keys);
+        std::pair<RandomIt, RandomIt> middle;
+        if (last - first > options.parallelPartitionCutoff) {
+            RandomIt split = parallelPartition(group.pool(), first, last, pivot, keys, options.partitionBlockSize);
+            middle = {split, split};
+        } else if constexpr (isDualPivot<typename Policy::Partition>) {
+            RandomIt split = hqsort::partition(first, last, pivot, keys);
+            middle = {split, split};
+        } else {
+            middle = partitionRange<Policy>(first, last, pivot, keys);
+        }
+
+        // Hand the left side to the pool
+        RandomIt split = middle.first;
+        group.run([&group, first, split, &keys, &options, depthBudget] {
+            parallelQuickSort<Policy>(group, first, split, keys, options, depthBudget);
+        });
+
+        // Keep splitting the right side on this thread
+        first = middle.second;
+    }
+    quickSort<Policy>(first, last, keys, depthBudget);
+}
+
+} // namespace detail
+
+/**
+ * Sorts [first, last) with the proposed quicksort on a work-stealing pool.
+ * The calling thread takes part in the sort and returns once every element
+ * is in place; an exception thrown by the comparator or projection on any
+ * thread is rethrown here. options.threads is ignored in favour of the
+ * pool's own thread count.
+ *
+ * @param pool The pool to run on
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param options The grain size and parallel partition settings
+ * @param comp The strict weak ordering of keys
+ * @param proj The projection from an element to its key
+ */
+template <class Policy = DefaultPolicy, class RandomIt,
+          class Compare = std::less<>, class Projection = identity>
+void parallelSort(ThreadPool& pool, RandomIt first, RandomIt last,
+                  ParallelOptions options = {}, Compare comp = {},
+                  Projection proj = {}) {
+    KeyCompare<Compare, Projection> keys{comp, proj};
+
+    // Adaptive policies finish presorted input without partitioning
+    if (Policy::adaptive && mergeNaturalRuns(first, last, keys)) {
+        return;
+    }
+
+    // The pivot rules need at least 4 elements, so never split below that
+    options.grainSize = std::max<std::ptrdiff_t>({options.grainSize, Policy::insertionSortCutoff, 3});
+    options.partitionBlockSize = std::max<std::ptrdiff_t>(options.partitionBlockSize, 1);
+    if (pool.threads() == 1) {
+        options.parallelPartitionCutoff = last - first;
+    }
+
+    // Sort on this thread, queuing sides for the pool as we go, then help
+    // run the queued sides until all of them are sorted
+    TaskGroup group(pool);
+    try {
+        detail::parallelQuickSort<Policy>(group, first, last, keys, options,
+                                          detail::depthBudget(last - first));
+    } catch (...) {
+        group.fail(std::current_exception());
+    }
+    group.wait();
+}
+
+/**
+ * Sorts [first, last) with the proposed quicksort on a pool of
+ * options.threads threads created for this call.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param options The thread count, grain size and parallel partition settings
+ * @param comp The strict weak ordering of keys
+ * @param proj The projection from an element to its key
+ */
+template <class Policy = DefaultPolicy, class RandomIt,
+          class Compare = std::less<>, class Projection = identity>
+void parallelSort(RandomIt first, RandomIt last, ParallelOptions options = {},
+                  Compare comp = {}, Projection proj = {}) {
+    // A single thread, or a range that would not be split, needs no pool
+    if (options.threads <= 1 || last - first <= options.grainSize) {
+        KeyCompare<Compare, Projection> keys{comp, proj};
+        quickSort<Policy>(first, last, keys);
+        return;
+    }
+
+    ThreadPool pool(options.threads);
+    parallelSort<Policy>(pool, first, last, options, comp, proj);
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_PARALLEL_HPP
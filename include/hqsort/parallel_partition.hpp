@@ -0,0 +1,167 @@
+#ifndef HQSORT_PARALLEL_PARTITION_HPP
+#define HQSORT_PARALLEL_PARTITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "keys.hpp"
+#include "partition.hpp"
+#include "thread_pool.hpp"
+
+namespace hqsort {
+
+namespace detail {
+
+/**
+ * A run of misplaced elements found by parallelPartition: length elements
+ * starting at position, preceded by offset misplaced elements of the same
+ * kind.
+ */
+struct MisplacedRun {
+    std::ptrdiff_t position;
+    std::ptrdiff_t length;
+    std::ptrdiff_t offset;
+};
+
+/**
+ * Swaps the misplaced elements numbered [begin, end) of the two run lists
+ * with each other.
+ *
+ * @param first The start of the range being partitioned
+ * @param left The runs of right-side elements lying in the left side
+ * @param right The runs of left-side elements lying in the right side
+ * @param begin The first misplaced element to swap
+ * @param end One past the last misplaced element to swap
+ */
+template <class RandomIt>
+void swapMisplaced(RandomIt first, const std::vector<MisplacedRun>& left,
+                   const std::vector<MisplacedRun>& right, std::ptrdiff_t begin,
+                   std::ptrdiff_t end) {
+    auto byOffset = [](std::ptrdiff_t k, const MisplacedRun& run) {
+        return k < run.offset;
+    };
+
+    // Find the runs that hold misplaced element number begin
+    std::size_t a = std::upper_bound(left.begin(), left.end(), begin, byOffset) - left.begin() - 1;
+    std::size_t b = std::upper_bound(right.begin(), right.end(), begin, byOffset) - right.begin() - 1;
+
+    // Swap run by run until end
+    std::ptrdiff_t k = begin;
+    while (k < end) {
+        std::ptrdiff_t inA = k - left[a].offset;
+        std::ptrdiff_t inB = k - right[b].offset;
+        std::ptrdiff_t count = std::min({left[a].length - inA, right[b].length - inB, end - k});
+
+        std::swap_ranges(first + left[a].position + inA,
+                         first + left[a].position + inA + count,
+                         first + right[b].position + inB);
+
+        k += count;
+        if (inA + count == left[a].length) {
+            ++a;
+        }
+        if (inB + count == right[b].length) {
+            ++b;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Partitions a range around a pivot key on a thread pool.
+ *
+ * The range is cut into fixed-size blocks. In the first phase each block is
+ * partitioned on its own by one task, putting the keys ordered before the
+ * pivot at its front. The per-block counts give the final split point; in
+ * the cleanup phase the elements each block left on the wrong side of that
+ * point are swapped across it, also in block-sized tasks.
+ *
+ * The result keeps the contract of partition(): no key in [first, split) is
+ * ordered after the pivot, no key in [split, last) is ordered before it, and
+ * both sides are non-empty. If the pivot equals the smallest key, so that
+ * nothing is ordered before it, the range is handed to the sequential Hoare
+ * partition instead.
+ *
+ * @param pool The pool to run the blocks on
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param pivot The pivot key to partition around
+ * @param keys The comparator and projection to order elements by
+ * @param blockSize The number of elements per task
+ *
+ * @return The split point
+ */
+template <class RandomIt, class Key, class Keys>
+RandomIt parallelPartition(ThreadPool& pool, RandomIt first, RandomIt last,
+                           const Key& pivot, const Keys& keys,
+                           std::ptrdiff_t blockSize) {
+    std::ptrdiff_t n = last - first;
+    std::ptrdiff_t blocks = (n + blockSize - 1) / blockSize;
+    std::vector<std::ptrdiff_t> leftCounts(blocks);
+
+    // Phase 1: partition every block on its own
+    TaskGroup classify(pool);
+    for (std::ptrdiff_t b = 0; b < blocks; ++b) {
+        classify.run([&, b] {
+            RandomIt blockFirst = first + b * blockSize;
+            RandomIt blockLast = first + std::min(n, (b + 1) * blockSize);
+            RandomIt blockSplit = std::partition(blockFirst, blockLast, [&](const auto& value) {
+                return keys.less(keys.key(value), pivot);
+            });
+            leftCounts[b] = blockSplit - blockFirst;
+        });
+    }
+    classify.wait();
+
+    // The split point is the total number of keys ordered before the pivot
+    std::ptrdiff_t split = 0;
+    for (std::ptrdiff_t count : leftCounts) {
+        split += count;
+    }
+    if (split == 0 || split == n) {
+        return partition(first, last, pivot, keys);
+    }
+
+    // Collect the runs each block left on the wrong side of the split point
+    std::vector<detail::MisplacedRun> misplacedLeft;
+    std::vector<detail::MisplacedRun> misplacedRight;
+    std::ptrdiff_t leftTotal = 0;
+    std::ptrdiff_t rightTotal = 0;
+    for (std::ptrdiff_t b = 0; b < blocks; ++b) {
+        std::ptrdiff_t blockFirst = b * blockSize;
+        std::ptrdiff_t blockSplit = blockFirst + leftCounts[b];
+        std::ptrdiff_t blockLast = std::min(n, (b + 1) * blockSize);
+
+        // Right-side keys in front of the split point
+        std::ptrdiff_t runEnd = std::min(blockLast, split);
+        if (blockSplit < runEnd) {
+            misplacedLeft.push_back({blockSplit, runEnd - blockSplit, leftTotal});
+            leftTotal += runEnd - blockSplit;
+        }
+
+        // Left-side keys behind the split point
+        std::ptrdiff_t runStart = std::max(blockFirst, split);
+        if (runStart < blockSplit) {
+            misplacedRight.push_back({runStart, blockSplit - runStart, rightTotal});
+            rightTotal += blockSplit - runStart;
+        }
+    }
+
+    // Phase 2: swap the misplaced elements across the split point
+    TaskGroup cleanup(pool);
+    for (std::ptrdiff_t begin = 0; begin < leftTotal; begin += blockSize) {
+        cleanup.run([&, begin] {
+            detail::swapMisplaced(first, misplacedLeft, misplacedRight, begin,
+                                  std::min(leftTotal, begin + blockSize));
+        });
+    }
+    cleanup.wait();
+
+    return first + split;
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_PARALLEL_PARTITION_HPP
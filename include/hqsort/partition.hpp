@@ -0,0 +1,72 @@
+#ifndef HQSORT_PARTITION_HPP
+#define HQSORT_PARTITION_HPP
+
+#include <iterator>
+#include <utility>
+
+#include "keys.hpp"
+#include "operation_counts.hpp"
+
+namespace hqsort {
+
+/**
+ * Hoare partition of a range around a pivot key.
+ *
+ * The pivot must lie between the smallest and largest key of the range (all
+ * built-in pivot rules guarantee this), which keeps both scans in bounds.
+ * When rounding makes the pivot equal to a unique largest key sitting at the
+ * end, the scans cross at the last element; that element is then already in
+ * place and is split off on its own so both sides are always non-empty.
+ *
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param pivot The pivot key to partition around
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The split point: no key in [first, split) is ordered after the
+ *         pivot and no key in [split, last) is ordered before it
+ */
+template <class RandomIt, class Key, class Keys>
+RandomIt partition(RandomIt first, RandomIt last, const Key& pivot,
+                   const Keys& keys) {
+    using std::iter_swap;
+
+    // Initialize the offsets of the left and right elements
+    DifferenceType<RandomIt> i = -1;
+    DifferenceType<RandomIt> j = last - first;
+
+    // Partition the range around the pivot key
+    while (true) {
+        // Move the left offset up until the key is not below the pivot
+        while (keys.less(keys.key(first[++i]), pivot));
+
+        // Move the right offset down until the key is not above the pivot
+        while (keys.less(pivot, keys.key(first[--j])));
+
+        // If the offsets have crossed over each other, the range is split;
+        // each scan compared once per step
+        if (i >= j) {
+            countOperations(&OperationCounts::partitionComparisons, (i + 1) + (last - first - j));
+            return j + 1 == last - first ? first + j : first + j + 1;
+        }
+
+        // Swap the elements at the current offsets
+        iter_swap(first + i, first + j);
+        countOperations(&OperationCounts::swaps);
+    }
+}
+
+/**
+ * Partition policy running the Hoare partition above.
+ */
+struct HoarePartition {
+    template <class RandomIt, class Key, class Keys>
+    static RandomIt partition(RandomIt first, RandomIt last, const Key& pivot,
+                              const Keys& keys) {
+        return hqsort::partition(first, last, pivot, keys);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_PARTITION_HPP
@@ -0,0 +1,348 @@
+#ifndef HQSORT_PIVOT_HPP
+#define HQSORT_PIVOT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "keys.hpp"
+
+namespace hqsort {
+
+/**
+ * Averages two keys without overflowing the key type.
+ *
+ * Integers are averaged with the carry-free (a & b) + ((a ^ b) >> 1) form,
+ * which rounds toward negative infinity and always lies in [min(a, b),
+ * max(a, b)], so a pivot built from it can never fall outside the range.
+ *
+ * @param a The first key
+ * @param b The second key
+ *
+ * @return The average of a and b
+ */
+template <class T>
+constexpr T average(T a, T b) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<T>((a & b) + ((a ^ b) >> 1));
+    } else {
+        return a / 2 + b / 2;
+    }
+}
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+using WideInt = __int128;
+#else
+using WideInt = std::int64_t;
+#endif
+
+/**
+ * True when the mean of Key values can be computed exactly in integers: keys
+ * of up to 32 bits sum into 64 bits, wider keys need a 128-bit accumulator.
+ */
+template <class Key>
+constexpr bool hasExactMean =
+    std::is_integral_v<Key> && (sizeof(Key) <= 4 || sizeof(WideInt) > 8);
+
+/**
+ * Sums the keys of a range into four independent lanes so the loop carries
+ * no serial dependency and vectorizes for contiguous keys.
+ *
+ * @param first The start of the range
+ * @param last The end of the range
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The sum of all keys in Acc arithmetic
+ */
+template <class Acc, class RandomIt, class Keys>
+Acc sumKeys(RandomIt first, RandomIt last, const Keys& keys) {
+    Acc lane0 = 0, lane1 = 0, lane2 = 0, lane3 = 0;
+    DifferenceType<RandomIt> n = last - first;
+    DifferenceType<RandomIt> i = 0;
+
+    // Add four keys per step, one into each lane
+    for (; i + 4 <= n; i += 4) {
+        lane0 += keys.key(first[i]);
+        lane1 += keys.key(first[i + 1]);
+        lane2 += keys.key(first[i + 2]);
+        lane3 += keys.key(first[i + 3]);
+    }
+
+    // Add the remaining keys
+    for (; i < n; ++i) {
+        lane0 += keys.key(first[i]);
+    }
+
+    return (lane0 + lane1) + (lane2 + lane3);
+}
+
+/**
+ * Divides sum by count rounding toward negative infinity.
+ *
+ * @param sum The dividend
+ * @param count The positive divisor
+ * @param quotient Receives floor(sum / count)
+ * @param remainder Receives the remainder, in [0, count)
+ */
+template <class Acc>
+void floorDivide(Acc sum, Acc count, Acc& quotient, Acc& remainder) {
+    quotient = sum / count;
+    remainder = sum % count;
+    if (remainder < 0) {
+        quotient -= 1;
+        remainder += count;
+    }
+}
+
+/**
+ * Returns the median of three keys under the comparator.
+ */
+template <class Key, class Keys>
+Key medianOf3(const Key& a, const Key& b, const Key& c, const Keys& keys) {
+    if (keys.less(b, a)) {
+        return keys.less(c, b) ? b : (keys.less(c, a) ? c : a);
+    }
+    return keys.less(c, a) ? a : (keys.less(c, b) ? c : b);
+}
+
+/**
+ * Returns the next value of a per-thread splitmix64 sequence. The sequence
+ * starts from a fixed seed, so sampled pivots are reproducible from run to
+ * run.
+ */
+inline std::uint64_t nextSample() {
+    static thread_local std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace detail
+
+/**
+ * Hossain's pivot: the mean of the means of the left and right halves of the
+ * range. Requires arithmetic keys.
+ *
+ * Both halves are summed in one streaming pass without copying. Integer keys
+ * are summed exactly in a 64-bit (128-bit for 64-bit keys) accumulator and
+ * the mean of means is rounded toward negative infinity, which matches the
+ * original double arithmetic for non-negative keys and never leaves the key
+ * range. Floating-point keys are summed in long double and clamped to the
+ * bounds found by a second scan, since rounding may push the mean past the
+ * largest key.
+ */
+struct MeanOfHalvesPivot {
+    /**
+     * Calculates the pivot for a range of at least 2 elements.
+     *
+     * @param first The start of the range
+     * @param last The end of the range
+     * @param keys The comparator and projection to order elements by
+     *
+     * @return The calculated pivot key
+     */
+    template <class RandomIt, class Keys>
+    static KeyType<RandomIt, Keys> calculatePivot(RandomIt first, RandomIt last,
+                                                  const Keys& keys) {
+        using Key = KeyType<RandomIt, Keys>;
+        static_assert(std::is_arithmetic_v<Key>,
+                      "MeanOfHalvesPivot requires arithmetic keys");
+
+        // Split the range after the middle element.
+        RandomIt mid = first + (last - first - 1) / 2 + 1;
+
+        if constexpr (detail::hasExactMean<Key>) {
+            using Acc = std::conditional_t<sizeof(Key) <= 4, std::int64_t,
+                                           detail::WideInt>;
+            Acc leftCount = mid - first;
+            Acc rightCount = last - mid;
+
+            // Sum each half and split each mean into whole and fractional parts.
+            Acc leftWhole, leftRest, rightWhole, rightRest;
+            detail::floorDivide(detail::sumKeys<Acc>(first, mid, keys), leftCount,
+                                leftWhole, leftRest);
+            detail::floorDivide(detail::sumKeys<Acc>(mid, last, keys), rightCount,
+                                rightWhole, rightRest);
+
+            // floor((leftMean + rightMean) / 2): the fractional parts add up
+            // to less than 2, so they only carry when the whole parts are odd
+            // and the fractions reach 1 together.
+            Acc wholeSum = leftWhole + rightWhole;
+            bool carry = (wholeSum & 1) != 0 &&
+                         detail::WideInt(leftRest) * rightCount +
+                                 detail::WideInt(rightRest) * leftCount >=
+                             detail::WideInt(leftCount) * rightCount;
+            return static_cast<Key>((wholeSum >> 1) + (carry ? 1 : 0));
+        } else {
+            long double leftMean = detail::sumKeys<long double>(first, mid, keys) / (mid - first);
+            long double rightMean = detail::sumKeys<long double>(mid, last, keys) / (last - mid);
+            Key pivot = static_cast<Key>((leftMean + rightMean) / 2);
+
+            // Keep the pivot inside the range so the partition scans stop.
+            Key low = keys.key(*first);
+            Key high = low;
+            for (RandomIt it = first; it != last; ++it) {
+                Key value = keys.key(*it);
+                low = value < low ? value : low;
+                high = high < value ? value : high;
+            }
+            return pivot < low ? low : (high < pivot ? high : pivot);
+        }
+    }
+};
+
+/**
+ * The proposed pivot: the mid-range of the low/mid-1 probe pair averaged
+ * with the mid-range of the mid/high probe pair. Requires arithmetic keys.
+ */
+struct MinMaxProbePivot {
+    /**
+     * Calculates the pivot for a range of at least 4 elements.
+     *
+     * @param first The start of the range
+     * @param last The end of the range
+     * @param keys The comparator and projection to order elements by
+     *
+     * @return The calculated pivot key
+     */
+    template <class RandomIt, class Keys>
+    static KeyType<RandomIt, Keys> calculatePivot(RandomIt first, RandomIt last,
+                                                  const Keys& keys) {
+        using Key = KeyType<RandomIt, Keys>;
+        static_assert(std::is_arithmetic_v<Key>,
+                      "MinMaxProbePivot requires arithmetic keys");
+
+        // Calculate the midpoint of the range.
+        RandomIt mid = first + (last - first - 1) / 2;
+
+        // Order the probes on the left of the midpoint.
+        Key leftA = keys.key(first[0]);
+        Key leftB = keys.key(mid[-1]);
+        Key leftMin = keys.less(leftB, leftA) ? leftB : leftA;
+        Key leftMax = keys.less(leftB, leftA) ? leftA : leftB;
+
+        // Order the probes on the right of the midpoint.
+        Key rightA = keys.key(mid[0]);
+        Key rightB = keys.key(last[-1]);
+        Key rightMin = keys.less(rightB, rightA) ? rightB : rightA;
+        Key rightMax = keys.less(rightB, rightA) ? rightA : rightB;
+
+        // Calculate the mid-range of each side, then average them.
+        Key leftMean = average(leftMin, leftMax);
+        Key rightMean = average(rightMin, rightMax);
+        return average(leftMean, rightMean);
+    }
+};
+
+/**
+ * The median of the first, middle and last keys. Works with any keys.
+ */
+struct MedianOfThreePivot {
+    /**
+     * Calculates the pivot for a range of at least 3 elements.
+     *
+     * @param first The start of the range
+     * @param last The end of the range
+     * @param keys The comparator and projection to order elements by
+     *
+     * @return The calculated pivot key
+     */
+    template <class RandomIt, class Keys>
+    static KeyType<RandomIt, Keys> calculatePivot(RandomIt first, RandomIt last,
+                                                  const Keys& keys) {
+        RandomIt mid = first + (last - first) / 2;
+        return detail::medianOf3(keys.key(*first), keys.key(*mid), keys.key(last[-1]), keys);
+    }
+};
+
+/**
+ * Tukey's ninther: the median of the medians of three groups of three keys
+ * spread over the range. Ranges below 40 elements take the median of three
+ * instead. Works with any keys.
+ */
+struct NintherPivot {
+    /**
+     * Calculates the pivot for a range of at least 3 elements.
+     *
+     * @param first The start of the range
+     * @param last The end of the range
+     * @param keys The comparator and projection to order elements by
+     *
+     * @return The calculated pivot key
+     */
+    template <class RandomIt, class Keys>
+    static KeyType<RandomIt, Keys> calculatePivot(RandomIt first, RandomIt last,
+                                                  const Keys& keys) {
+        auto N = last - first;
+        if (N < 40) {
+            return MedianOfThreePivot::calculatePivot(first, last, keys);
+        }
+
+        // Take a median from each end and from the middle, one eighth apart
+        auto step = N / 8;
+        RandomIt mid = first + N / 2;
+        RandomIt back = last - 1;
+        return detail::medianOf3(
+            detail::medianOf3(keys.key(first[0]), keys.key(first[step]), keys.key(first[2 * step]), keys),
+            detail::medianOf3(keys.key(mid[-step]), keys.key(mid[0]), keys.key(mid[step]), keys),
+            detail::medianOf3(keys.key(back[-2 * step]), keys.key(back[-step]), keys.key(back[0]), keys),
+            keys);
+    }
+};
+
+/**
+ * The median of the keys of Samples elements drawn at random, with
+ * replacement, from the range. Ranges below 8 * Samples elements, where
+ * sampling costs more than it saves, take the median of three instead.
+ * Works with any keys.
+ *
+ * Positions come from a per-thread pseudo-random sequence with a fixed
+ * seed, so runs are reproducible. The sequence is not secret: an input
+ * built against it can still force bad splits, so inputs that may be
+ * adversarial need DepthLimitedPolicy for the O(n log n) bound. Larger
+ * samples cost more per partition and split closer to the median.
+ *
+ * @tparam Samples The odd number of elements to sample
+ */
+template <std::size_t Samples = 9>
+struct SampledPivot {
+    static_assert(Samples % 2 == 1, "SampledPivot needs an odd sample size");
+
+    /**
+     * Calculates the pivot for a range of at least 3 elements.
+     *
+     * @param first The start of the range
+     * @param last The end of the range
+     * @param keys The comparator and projection to order elements by
+     *
+     * @return The calculated pivot key
+     */
+    template <class RandomIt, class Keys>
+    static KeyType<RandomIt, Keys> calculatePivot(RandomIt first, RandomIt last,
+                                                  const Keys& keys) {
+        auto N = static_cast<std::uint64_t>(last - first);
+        if (N < 8 * Samples) {
+            return MedianOfThreePivot::calculatePivot(first, last, keys);
+        }
+
+        std::array<RandomIt, Samples> sample;
+        for (RandomIt& element : sample) {
+            element = first + static_cast<DifferenceType<RandomIt>>(detail::nextSample() % N);
+        }
+
+        auto middle = sample.begin() + Samples / 2;
+        std::nth_element(sample.begin(), middle, sample.end(), [&](RandomIt a, RandomIt b) {
+            return keys.less(keys.key(*a), keys.key(*b));
+        });
+        return keys.key(**middle);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_PIVOT_HPP
@@ -0,0 +1,124 @@
+#ifndef HQSORT_POLICY_HPP
+#define HQSORT_POLICY_HPP
+
+#include <cstddef>
+
+#include "leaf.hpp"
+#include "partition.hpp"
+#include "pivot.hpp"
+
+namespace hqsort {
+
+/**
+ * Compile-time configuration of the sort.
+ *
+ * Derive from DefaultPolicy and shadow the members to change one setting:
+ *
+ *     struct MyPolicy : hqsort::DefaultPolicy {
+ *         static constexpr std::ptrdiff_t insertionSortCutoff = 50;
+ *     };
+ *
+ * Ranges of at most 3 elements always go to manualSort; ranges of at most
+ * insertionSortCutoff elements go to the Leaf routine (InsertionSortLeaf,
+ * or SortingNetworkLeaf from sorting_network.hpp). A cutoff of 3 or less
+ * disables the leaf, which is Hossain's original algorithm. Pivot
+ * computes the pivot key of a range (MinMaxProbePivot, MeanOfHalvesPivot,
+ * MedianOfThreePivot, NintherPivot or SampledPivot<K>) and Partition
+ * splits the range around it (HoarePartition, BlockPartition from
+ * block_partition.hpp, SimdPartition from simd_partition.hpp,
+ * ThreeWayPartition from three_way_partition.hpp, or DualPivotPartition
+ * from dual_pivot_partition.hpp, which picks two pivots of its own).
+ *
+ * With depthLimited set, a range still being partitioned after
+ * 2 * log2(n) levels is heapsorted instead, which bounds the sort to
+ * O(n log n) time on adversarial input. The recursion depth is at most
+ * log2(n) with or without it.
+ *
+ * With adaptive set, the sort first looks for natural runs
+ * (mergeNaturalRuns in natural_runs.hpp): sorted and reversed input is
+ * finished in O(n) in place, and input made of a few long runs is merged
+ * instead of partitioned, with a temporary buffer of up to n elements.
+ *
+ * With radix set, ranges of integer keys up to 32 bits ordered by
+ * std::less or std::greater go to radixSort (radix_sort.hpp) when they are
+ * large enough for its key span to pay off; smaller ranges and other keys
+ * take the quicksort. parallelSort ignores it.
+ *
+ * With counting set, ranges of integers up to 32 bits that are their own
+ * keys, ordered by std::less or std::greater, are counting sorted
+ * (countingSort in counting_sort.hpp) once their key span is at most their
+ * size and its histogram fits in L2. One min/max scan bounds the keys of
+ * the whole range; each partition then bounds its sides by the pivot, so
+ * subranges are checked without scanning them again. parallelSort ignores
+ * it.
+ */
+struct DefaultPolicy {
+    static constexpr std::ptrdiff_t insertionSortCutoff = 10;
+    using Pivot = MinMaxProbePivot;
+    using Partition = HoarePartition;
+    using Leaf = InsertionSortLeaf;
+    static constexpr bool depthLimited = false;
+    static constexpr bool adaptive = false;
+    static constexpr bool radix = false;
+    static constexpr bool counting = false;
+};
+
+/**
+ * The proposed algorithm with a given leaf threshold, pivot, partition
+ * scheme and leaf routine.
+ */
+template <std::ptrdiff_t Threshold, class PivotRule = MinMaxProbePivot,
+          class PartitionScheme = HoarePartition,
+          class LeafRoutine = InsertionSortLeaf>
+struct ProposedPolicy : DefaultPolicy {
+    static constexpr std::ptrdiff_t insertionSortCutoff = Threshold;
+    using Pivot = PivotRule;
+    using Partition = PartitionScheme;
+    using Leaf = LeafRoutine;
+};
+
+/**
+ * Hossain's quicksort: manualSort leaves only, no insertion sort.
+ */
+template <class PivotRule = MinMaxProbePivot>
+using HossainPolicy = ProposedPolicy<3, PivotRule>;
+
+/**
+ * Any policy with the introsort depth limit switched on.
+ */
+template <class Base = DefaultPolicy>
+struct DepthLimitedPolicy : Base {
+    static constexpr bool depthLimited = true;
+};
+
+/**
+ * Any policy with the natural run pre-pass switched on.
+ */
+template <class Base = DefaultPolicy>
+struct AdaptivePolicy : Base {
+    static constexpr bool adaptive = true;
+};
+
+/**
+ * Any policy with the radix sort path switched on.
+ */
+template <class Base = DefaultPolicy>
+struct RadixPolicy : Base {
+    static constexpr bool radix = true;
+};
+
+/**
+ * Any policy with the counting sort path switched on.
+ */
+template <class Base = DefaultPolicy>
+struct CountingPolicy : Base {
+    static constexpr bool counting = true;
+};
+
+using Proposed10 = ProposedPolicy<10>;
+using Proposed50 = ProposedPolicy<50>;
+using Proposed100 = ProposedPolicy<100>;
+
+} // namespace hqsort
+
+#endif // HQSORT_POLICY_HPP
@@ -0,0 +1,229 @@
+#ifndef HQSORT_QUICKSORT_HPP
+#define HQSORT_QUICKSORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "counting_sort.hpp"
+#include "dual_pivot_partition.hpp"
+#include "heap_sort.hpp"
+#include "keys.hpp"
+#include "leaf.hpp"
+#include "natural_runs.hpp"
+#include "operation_counts.hpp"
+#include "partition.hpp"
+#include "policy.hpp"
+#include "radix_sort.hpp"
+
+namespace hqsort {
+
+namespace detail {
+
+/**
+ * Returns the number of partitioning levels a depth-limited sort allows
+ * for a range before it falls back to heapsort: twice the floor of
+ * log2(N), as in introsort.
+ *
+ * @param N The size of the range
+ */
+inline int depthBudget(std::ptrdiff_t N) {
+    int budget = 0;
+    for (; N > 1; N >>= 1) {
+        budget += 2;
+    }
+    return budget;
+}
+
+/**
+ * Partitions a range with the policy's scheme and returns the elements
+ * already in their final place: the keys equal to the pivot for schemes
+ * that return that range (ThreeWayPartition), or the empty range at the
+ * split point for schemes that return a split point.
+ *
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param pivot The pivot key to partition around
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The range to leave out of both sides
+ */
+template <class Policy, class RandomIt, class Key, class Keys>
+std::pair<RandomIt, RandomIt> partitionRange(RandomIt first, RandomIt last,
+                                             const Key& pivot, const Keys& keys) {
+    auto split = Policy::Partition::partition(first, last, pivot, keys);
+    if constexpr (std::is_same_v<decltype(split), std::pair<RandomIt, RandomIt>>) {
+        return split;
+    } else {
+        return {split, split};
+    }
+}
+
+/**
+ * True for partition schemes that split around two pivots of their own
+ * (DualPivotPartition) rather than the pivot of the policy's Pivot rule.
+ */
+template <class Scheme, class = void>
+constexpr bool isDualPivot = false;
+
+template <class Scheme>
+constexpr bool isDualPivot<Scheme, std::void_t<decltype(Scheme::dualPivot)>> = Scheme::dualPivot;
+
+/**
+ * Performs the proposed quicksort on a range with the given number of
+ * partitioning levels left. The budget only matters for policies with
+ * depthLimited set.
+ *
+ * Only the smaller side of each partition is sorted by a recursive call;
+ * the loop carries on with the larger side. Every call therefore sorts at
+ * most half of its caller's range, and the stack holds at most log2(N)
+ * frames whatever the input. Dual-pivot schemes split the range in three;
+ * the two smaller parts are sorted by recursive calls, so the bound holds
+ * for them too.
+ *
+ * Given KeyBounds (policies with counting set), the range is counting
+ * sorted as soon as its bounds are narrow enough, and each side of a
+ * partition inherits the bounds cut at the pivot.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ * @param depthBudget The partitioning levels left before heapsort takes over
+ * @param bounds The bounds of the keys in the range, or NoKeyBounds
+ */
+template <class Policy, class RandomIt, class Keys, class Bounds = NoKeyBounds>
+void quickSort(RandomIt first, RandomIt last, const Keys& keys, int depthBudget,
+               Bounds bounds = {}) {
+    constexpr bool tracksBounds = !std::is_same_v<Bounds, NoKeyBounds>;
+    PartitionLevelScope level;
+
+    // Partition while the range is too large for manualSort and the leaf
+    while (last - first > 3 && last - first > Policy::insertionSortCutoff) {
+        // If the keys have become dense enough, count them instead
+        if constexpr (tracksBounds) {
+            constexpr int Order = radixOrder<RandomIt, Keys>();
+            if (countingSortPays<Order>(last - first, bounds)) {
+                countingSortRange<Order>(first, last, bounds);
+                return;
+            }
+        }
+
+        // If the partitions have been too unbalanced for too long, use heapsort
+        if (Policy::depthLimited && depthBudget == 0) {
+            heapSort(first, last, keys);
+            return;
+        }
+        --depthBudget;
+
+        // Split around two pivots, recurse into the two smaller parts and
+        // keep looping on the largest one
+        if constexpr (isDualPivot<typename Policy::Partition>) {
+            auto split = Policy::Partition::partition(first, last, keys);
+            struct Part {
+                RandomIt first;
+                RandomIt last;
+                Bounds bounds;
+            };
+            Part parts[3] = {{first, split.lowPivot, bounds},
+                             {split.lowPivot + 1, split.highPivot, bounds},
+                             {split.highPivot + 1, last, bounds}};
+            if constexpr (tracksBounds) {
+                parts[0].bounds.last = split.low;
+                parts[1].bounds = {split.low, split.high};
+                parts[2].bounds.first = split.high;
+            }
+
+            // With equal pivots the middle part holds only their key
+            if (!keys.less(split.low, split.high)) {
+                parts[1].last = parts[1].first;
+            }
+
+            int largest = 0;
+            int smallest = 0;
+            for (int part = 1; part < 3; ++part) {
+                if (parts[part].last - parts[part].first > parts[largest].last - parts[largest].first) {
+                    largest = part;
+                }
+                if (parts[part].last - parts[part].first < parts[smallest].last - parts[smallest].first) {
+                    smallest = part;
+                }
+            }
+            countPartition(last - first, parts[smallest].last - parts[smallest].first);
+            for (int part = 0; part < 3; ++part) {
+                if (part != largest) {
+                    quickSort<Policy>(parts[part].first, parts[part].last, keys, depthBudget, parts[part].bounds);
+                }
+            }
+            first = parts[largest].first;
+            last = parts[largest].last;
+            bounds = parts[largest].bounds;
+        } else {
+            // Partition around the policy's pivot, recurse into the smaller
+            // side and keep looping on the larger one
+            auto pivot = Policy::Pivot::calculatePivot(first, last, keys);
+            auto [middleFirst, middleLast] = partitionRange<Policy>(first, last, pivot, keys);
+            countPartition(last - first, std::min(middleFirst - first, last - middleLast));
+            if (middleFirst - first < last - middleLast) {
+                Bounds leftBounds = bounds;
+                if constexpr (tracksBounds) {
+                    leftBounds.last = pivot;
+                    bounds.first = pivot;
+                }
+                quickSort<Policy>(first, middleFirst, keys, depthBudget, leftBounds);
+                first = middleLast;
+            } else {
+                Bounds rightBounds = bounds;
+                if constexpr (tracksBounds) {
+                    rightBounds.first = pivot;
+                    bounds.last = pivot;
+                }
+                quickSort<Policy>(middleLast, last, keys, depthBudget, rightBounds);
+                last = middleFirst;
+            }
+        }
+    }
+
+    // If the range size is less than or equal to 3, use manualSort
+    if (last - first <= 3) {
+        manualSort(first, last, keys);
+    }
+    // Otherwise it is within the policy's cutoff, so use its leaf routine
+    else {
+        Policy::Leaf::sort(first, last, keys);
+    }
+}
+
+} // namespace detail
+
+/**
+ * Performs the proposed quicksort on a range.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ */
+template <class Policy, class RandomIt, class Keys>
+void quickSort(RandomIt first, RandomIt last, const Keys& keys) {
+    // Adaptive policies finish presorted input without partitioning
+    if (Policy::adaptive && mergeNaturalRuns(first, last, keys)) {
+        return;
+    }
+    // Radix policies sort large ranges of integer keys without comparisons
+    if (Policy::radix && radixSort(first, last, keys)) {
+        return;
+    }
+    // Counting policies bound the keys once and count dense ranges
+    if constexpr (Policy::counting && detail::isCountingSortable<RandomIt, Keys>) {
+        if (first != last) {
+            detail::quickSort<Policy>(first, last, keys, detail::depthBudget(last - first),
+                                      detail::findKeyBounds(first, last, keys));
+            return;
+        }
+    }
+    detail::quickSort<Policy>(first, last, keys, detail::depthBudget(last - first));
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_QUICKSORT_HPP
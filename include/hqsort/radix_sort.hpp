@@ -0,0 +1,226 @@
+#ifndef HQSORT_RADIX_SORT_HPP
+#define HQSORT_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "keys.hpp"
+
+namespace hqsort {
+
+namespace detail {
+
+/**
+ * The comparator type bundled in a KeyCompare.
+ */
+template <class Keys>
+struct CompareOf;
+
+template <class Compare, class Projection>
+struct CompareOf<KeyCompare<Compare, Projection>> {
+    using type = Compare;
+};
+
+/**
+ * 1 if Keys orders keys ascending by value (std::less), -1 if descending
+ * (std::greater), and 0 for any other comparator.
+ */
+template <class RandomIt, class Keys>
+constexpr int radixOrder() {
+    using Key = KeyType<RandomIt, Keys>;
+    using Compare = typename CompareOf<Keys>::type;
+    if constexpr (std::is_same_v<Compare, std::less<>> ||
+                  std::is_same_v<Compare, std::less<Key>>) {
+        return 1;
+    } else if constexpr (std::is_same_v<Compare, std::greater<>> ||
+                         std::is_same_v<Compare, std::greater<Key>>) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
+
+/**
+ * True when radixSort applies: integer keys of at most 32 bits ordered by
+ * std::less or std::greater, on elements that can be copied into a
+ * scratch buffer.
+ */
+template <class RandomIt, class Keys>
+constexpr bool isRadixSortable =
+    radixOrder<RandomIt, Keys>() != 0 &&
+    std::is_integral_v<KeyType<RandomIt, Keys>> &&
+    !std::is_same_v<KeyType<RandomIt, Keys>, bool> &&
+    sizeof(KeyType<RandomIt, Keys>) <= sizeof(std::uint32_t) &&
+    std::is_trivially_copyable_v<typename std::iterator_traits<RandomIt>::value_type> &&
+    std::is_default_constructible_v<typename std::iterator_traits<RandomIt>::value_type>;
+
+/**
+ * Maps a key to an unsigned integer whose ascending order is the sort
+ * order: the sign bit of signed keys is flipped, and all bits are flipped
+ * for descending sorts.
+ */
+template <int Order, class Key>
+inline std::uint32_t radixKey(Key key) {
+    using Unsigned = std::make_unsigned_t<Key>;
+    std::uint32_t bits = static_cast<std::uint32_t>(static_cast<Unsigned>(key));
+    if constexpr (std::is_signed_v<Key>) {
+        bits ^= std::uint32_t(1) << (8 * sizeof(Key) - 1);
+    }
+    if constexpr (Order < 0) {
+        bits = ~bits;
+    }
+    return bits;
+}
+
+constexpr int kRadixBits = 11;
+constexpr std::size_t kRadixBuckets = std::size_t(1) << kRadixBits;
+
+/**
+ * The smallest range for which radixSort beats the proposed quicksort,
+ * indexed by the number of 11-bit digit passes the key span needs.
+ */
+constexpr std::array<std::ptrdiff_t, 4> kRadixMinimumSize = {0, 1 << 9, 1 << 10, 1 << 11};
+
+/**
+ * The largest scratch buffer a thread keeps between sorts. Larger sorts
+ * allocate their own, so one big sort does not pin n elements of memory to
+ * every thread that ever ran it.
+ */
+constexpr std::size_t kRadixKeptBufferBytes = std::size_t(1) << 20;
+
+/**
+ * Moves every element of [source, source + N) to its bucket in
+ * destination, in order, by one digit of its mapped key.
+ */
+template <int Order, class SourceIt, class DestinationIt, class Keys>
+void radixScatter(SourceIt source, std::ptrdiff_t N, DestinationIt destination,
+                  const Keys& keys, std::uint32_t minimum, int shift,
+                  std::ptrdiff_t* offsets) {
+    for (std::ptrdiff_t i = 0; i < N; ++i) {
+        std::uint32_t digit = ((radixKey<Order>(keys.key(source[i])) - minimum) >> shift) & (kRadixBuckets - 1);
+        destination[offsets[digit]++] = source[i];
+    }
+}
+
+} // namespace detail
+
+/**
+ * Sorts a range of integer keys with a least-significant-digit radix sort,
+ * in O(n) time per 11-bit digit of the key span.
+ *
+ * One scan finds the smallest and largest key; only the digits of their
+ * difference are sorted, so narrow key ranges need fewer passes (up to 3
+ * for 32-bit keys). The digit histograms of all passes are counted in one
+ * more scan, and passes whose digit is the same for every key are
+ * skipped. Elements are copied to a scratch buffer: each thread keeps one
+ * of up to kRadixKeptBufferBytes for its small sorts, and larger sorts
+ * allocate theirs for the call.
+ *
+ * Ranges below the size at which radix sort pays off for the passes they
+ * need are left to the caller.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return true if the range was sorted; false if radix sort does not apply
+ *         to the key type or comparator, or the range is too small
+ */
+template <class RandomIt, class Keys>
+bool radixSort(RandomIt first, RandomIt last, const Keys& keys) {
+    if constexpr (!detail::isRadixSortable<RandomIt, Keys>) {
+        return false;
+    } else {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+        constexpr int Order = detail::radixOrder<RandomIt, Keys>();
+
+        auto N = last - first;
+        if (N < detail::kRadixMinimumSize[1]) {
+            return false;
+        }
+
+        // Find the span of the mapped keys
+        std::uint32_t minimum = detail::radixKey<Order>(keys.key(first[0]));
+        std::uint32_t maximum = minimum;
+        for (RandomIt i = first + 1; i != last; ++i) {
+            std::uint32_t key = detail::radixKey<Order>(keys.key(*i));
+            minimum = std::min(minimum, key);
+            maximum = std::max(maximum, key);
+        }
+        std::uint32_t span = maximum - minimum;
+        int passes = 0;
+        while (passes * detail::kRadixBits < 32 && (span >> (passes * detail::kRadixBits)) != 0) {
+            ++passes;
+        }
+        if (passes == 0) {
+            return true;
+        }
+        if (N < detail::kRadixMinimumSize[passes]) {
+            return false;
+        }
+
+        // Count the digits of every pass at once, in one table for the call
+        std::vector<std::ptrdiff_t> counts(passes * detail::kRadixBuckets, 0);
+        for (RandomIt i = first; i != last; ++i) {
+            std::uint32_t key = detail::radixKey<Order>(keys.key(*i)) - minimum;
+            for (int pass = 0; pass < passes; ++pass) {
+                std::uint32_t digit = (key >> (pass * detail::kRadixBits)) & (detail::kRadixBuckets - 1);
+                ++counts[pass * detail::kRadixBuckets + digit];
+            }
+        }
+
+        // Reuse the thread's buffer for small sorts; allocate one for large sorts
+        static thread_local std::vector<Value> keptBuffer;
+        std::unique_ptr<Value[]> ownBuffer;
+        Value* buffer;
+        if (static_cast<std::size_t>(N) * sizeof(Value) <= detail::kRadixKeptBufferBytes) {
+            if (keptBuffer.size() < static_cast<std::size_t>(N)) {
+                keptBuffer.resize(static_cast<std::size_t>(N));
+            }
+            buffer = keptBuffer.data();
+        } else {
+            ownBuffer.reset(new Value[static_cast<std::size_t>(N)]);
+            buffer = ownBuffer.get();
+        }
+
+        // Scatter back and forth between the range and the buffer
+        bool inBuffer = false;
+        for (int pass = 0; pass < passes; ++pass) {
+            std::ptrdiff_t* count = counts.data() + pass * detail::kRadixBuckets;
+            if (std::find(count, count + detail::kRadixBuckets, N) != count + detail::kRadixBuckets) {
+                continue;
+            }
+
+            std::ptrdiff_t offset = 0;
+            for (std::size_t digit = 0; digit < detail::kRadixBuckets; ++digit) {
+                std::ptrdiff_t size = count[digit];
+                count[digit] = offset;
+                offset += size;
+            }
+
+            int shift = pass * detail::kRadixBits;
+            if (inBuffer) {
+                detail::radixScatter<Order>(buffer, N, first, keys, minimum, shift, count);
+            } else {
+                detail::radixScatter<Order>(first, N, buffer, keys, minimum, shift, count);
+            }
+            inBuffer = !inBuffer;
+        }
+        if (inBuffer) {
+            std::copy(buffer, buffer + N, first);
+        }
+        return true;
+    }
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_RADIX_SORT_HPP
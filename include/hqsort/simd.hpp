@@ -0,0 +1,68 @@
+#ifndef HQSORT_SIMD_HPP
+#define HQSORT_SIMD_HPP
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "keys.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HQSORT_HAS_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define HQSORT_HAS_X86_SIMD 0
+#endif
+
+namespace hqsort {
+
+/**
+ * The widest vector instruction set the running CPU supports.
+ */
+enum class SimdLevel {
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+/**
+ * Detects the SIMD level of the running CPU once, through CPUID.
+ *
+ * @return The widest supported level
+ */
+inline SimdLevel simdLevel() {
+#if HQSORT_HAS_X86_SIMD
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::Avx2;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+namespace detail {
+
+/**
+ * True when the SIMD kernels apply: contiguous int elements ordered
+ * ascending by their own value.
+ */
+template <class RandomIt, class Keys>
+constexpr bool isSimdIntRange =
+    (std::is_same_v<RandomIt, int*> ||
+     std::is_same_v<RandomIt, std::vector<int>::iterator>) &&
+    (std::is_same_v<Keys, KeyCompare<std::less<>, identity>> ||
+     std::is_same_v<Keys, KeyCompare<std::less<int>, identity>>);
+
+} // namespace detail
+
+} // namespace hqsort
+
+#endif // HQSORT_SIMD_HPP
@@ -0,0 +1,261 @@
+#ifndef HQSORT_SIMD_PARTITION_HPP
+#define HQSORT_SIMD_PARTITION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "partition.hpp"
+#include "simd.hpp"
+
+namespace hqsort {
+
+namespace detail {
+
+/**
+ * Partitions count keys of the unpartitioned middle [left, right) with
+ * scalar code: keys not above the pivot join the front, larger keys join
+ * the back. The vector kernels use it to make the middle a multiple of the
+ * vector width, and to finish middles too short for two vectors.
+ *
+ * @param data The keys being partitioned
+ * @param left The start of the middle, advanced past the keys moved to the front
+ * @param right The end of the middle, moved before the keys moved to the back
+ * @param pivot The pivot key
+ * @param count The number of keys to take from the middle
+ *
+ * @return The new start of the middle
+ */
+inline std::ptrdiff_t partitionRemainder(int* data, std::ptrdiff_t& left,
+                                         std::ptrdiff_t& right, int pivot,
+                                         std::ptrdiff_t count) {
+    for (; count > 0; --count) {
+        if (data[left] <= pivot) {
+            ++left;
+        } else {
+            std::swap(data[left], data[--right]);
+        }
+    }
+    return left;
+}
+
+#if HQSORT_HAS_X86_SIMD
+
+/**
+ * For every 8-bit mask of lanes above the pivot, the lane order that puts
+ * the other lanes first and those lanes last, both in their original order.
+ */
+struct CompressTable {
+    std::array<std::array<std::int32_t, 8>, 256> order{};
+
+    constexpr CompressTable() {
+        for (int mask = 0; mask < 256; ++mask) {
+            int next = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (!(mask & (1 << lane))) {
+                    order[mask][next++] = lane;
+                }
+            }
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {
+                    order[mask][next++] = lane;
+                }
+            }
+        }
+    }
+};
+
+inline constexpr CompressTable compressTable{};
+
+/**
+ * Partitions 8 keys with AVX2: permutes them so the keys not above the
+ * pivot come first, then writes the whole vector at both store points. The
+ * caller guarantees 8 free slots at each, so the extra lanes only land on
+ * slots that are overwritten later.
+ *
+ * @return The number of keys above the pivot
+ */
+__attribute__((target("avx2,popcnt"))) inline int partitionVectorAvx2(
+    int* data, std::ptrdiff_t& leftStore, std::ptrdiff_t& rightStore,
+    __m256i keys, __m256i pivot) {
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(keys, pivot)));
+    int above = _mm_popcnt_u32(static_cast<unsigned>(mask));
+    __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compressTable.order[mask].data()));
+    __m256i permuted = _mm256_permutevar8x32_epi32(keys, order);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + leftStore), permuted);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + rightStore), permuted);
+    leftStore += 8 - above;
+    rightStore -= above;
+    return above;
+}
+
+/**
+ * In-place AVX2 partition of n ints, after the x86-simd-sort scheme:
+ * one vector from each end is held in registers to open 8 free slots on
+ * both sides, then vectors are loaded from whichever side has fewer free
+ * slots and written compressed to both store points.
+ *
+ * @param data The keys to partition
+ * @param n The number of keys
+ * @param pivot The pivot key
+ *
+ * @return The number of keys not above the pivot, which now come first
+ */
+__attribute__((target("avx2,popcnt"))) inline std::ptrdiff_t avx2PartitionInts(
+    int* data, std::ptrdiff_t n, int pivot) {
+    constexpr std::ptrdiff_t kLanes = 8;
+    std::ptrdiff_t left = 0;
+    std::ptrdiff_t right = n;
+    partitionRemainder(data, left, right, pivot, n % kLanes);
+    if (right - left < 2 * kLanes) {
+        return partitionRemainder(data, left, right, pivot, right - left);
+    }
+
+    __m256i pivotVector = _mm256_set1_epi32(pivot);
+    std::ptrdiff_t leftStore = left;
+    std::ptrdiff_t rightStore = right - kLanes;
+    __m256i firstVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + left));
+    __m256i lastVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + right - kLanes));
+    left += kLanes;
+    right -= kLanes;
+
+    while (left != right) {
+        // Load from the side with fewer free slots
+        __m256i keys;
+        if ((rightStore + kLanes) - right < left - leftStore) {
+            right -= kLanes;
+            keys = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + right));
+        } else {
+            keys = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + left));
+            left += kLanes;
+        }
+        partitionVectorAvx2(data, leftStore, rightStore, keys, pivotVector);
+    }
+
+    // The two held vectors fill the remaining free slots exactly
+    partitionVectorAvx2(data, leftStore, rightStore, firstVector, pivotVector);
+    partitionVectorAvx2(data, leftStore, rightStore, lastVector, pivotVector);
+    return leftStore;
+}
+
+/**
+ * Partitions 16 keys with AVX-512 compress-stores, writing only the lanes
+ * that belong at each store point.
+ *
+ * @return The number of keys above the pivot
+ */
+__attribute__((target("avx512f"))) inline int partitionVectorAvx512(
+    int* data, std::ptrdiff_t& leftStore, std::ptrdiff_t& rightStore,
+    __m512i keys, __m512i pivot) {
+    __mmask16 aboveMask = _mm512_cmpgt_epi32_mask(keys, pivot);
+    int above = __builtin_popcount(aboveMask);
+    _mm512_mask_compressstoreu_epi32(data + leftStore, static_cast<__mmask16>(~aboveMask), keys);
+    _mm512_mask_compressstoreu_epi32(data + rightStore + 16 - above, aboveMask, keys);
+    leftStore += 16 - above;
+    rightStore -= above;
+    return above;
+}
+
+/**
+ * In-place AVX-512 partition of n ints, with the same scheme as
+ * avx2PartitionInts on 16-lane vectors.
+ *
+ * @param data The keys to partition
+ * @param n The number of keys
+ * @param pivot The pivot key
+ *
+ * @return The number of keys not above the pivot, which now come first
+ */
+__attribute__((target("avx512f"))) inline std::ptrdiff_t avx512PartitionInts(
+    int* data, std::ptrdiff_t n, int pivot) {
+    constexpr std::ptrdiff_t kLanes = 16;
+    std::ptrdiff_t left = 0;
+    std::ptrdiff_t right = n;
+    partitionRemainder(data, left, right, pivot, n % kLanes);
+    if (right - left < 2 * kLanes) {
+        return partitionRemainder(data, left, right, pivot, right - left);
+    }
+
+    __m512i pivotVector = _mm512_set1_epi32(pivot);
+    std::ptrdiff_t leftStore = left;
+    std::ptrdiff_t rightStore = right - kLanes;
+    __m512i firstVector = _mm512_loadu_si512(data + left);
+    __m512i lastVector = _mm512_loadu_si512(data + right - kLanes);
+    left += kLanes;
+    right -= kLanes;
+
+    while (left != right) {
+        // Load from the side with fewer free slots
+        __m512i keys;
+        if ((rightStore + kLanes) - right < left - leftStore) {
+            right -= kLanes;
+            keys = _mm512_loadu_si512(data + right);
+        } else {
+            keys = _mm512_loadu_si512(data + left);
+            left += kLanes;
+        }
+        partitionVectorAvx512(data, leftStore, rightStore, keys, pivotVector);
+    }
+
+    // The two held vectors fill the remaining free slots exactly
+    partitionVectorAvx512(data, leftStore, rightStore, firstVector, pivotVector);
+    partitionVectorAvx512(data, leftStore, rightStore, lastVector, pivotVector);
+    return leftStore;
+}
+
+#endif // HQSORT_HAS_X86_SIMD
+
+} // namespace detail
+
+/**
+ * Partitions a range of ints around a pivot key with the widest vector
+ * kernel the CPU supports, chosen at run time through CPUID: AVX-512
+ * compress-stores on 16 keys, or AVX2 permutes on 8 keys per step. Keys not
+ * above the pivot go left, larger keys go right.
+ *
+ * Other element types, comparators and projections, CPUs without AVX2 and
+ * ranges where every key lands on one side use the scalar Hoare partition.
+ *
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param pivot The pivot key to partition around
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The split point, with the same contract as partition()
+ */
+template <class RandomIt, class Key, class Keys>
+RandomIt simdPartition(RandomIt first, RandomIt last, const Key& pivot,
+                       const Keys& keys) {
+#if HQSORT_HAS_X86_SIMD
+    if constexpr (detail::isSimdIntRange<RandomIt, Keys>) {
+        SimdLevel level = simdLevel();
+        if (level != SimdLevel::Scalar) {
+            int* data = &*first;
+            std::ptrdiff_t n = last - first;
+            std::ptrdiff_t split = level == SimdLevel::Avx512
+                ? detail::avx512PartitionInts(data, n, static_cast<int>(pivot))
+                : detail::avx2PartitionInts(data, n, static_cast<int>(pivot));
+            if (split > 0 && split < n) {
+                return first + split;
+            }
+        }
+    }
+#endif
+    return partition(first, last, pivot, keys);
+}
+
+/**
+ * Partition policy running simdPartition.
+ */
+struct SimdPartition {
+    template <class RandomIt, class Key, class Keys>
+    static RandomIt partition(RandomIt first, RandomIt last, const Key& pivot,
+                              const Keys& keys) {
+        return simdPartition(first, last, pivot, keys);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_SIMD_PARTITION_HPP
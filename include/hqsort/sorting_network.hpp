@@ -0,0 +1,389 @@
+#ifndef HQSORT_SORTING_NETWORK_HPP
+#define HQSORT_SORTING_NETWORK_HPP
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "keys.hpp"
+#include "leaf.hpp"
+#include "policy.hpp"
+#include "simd.hpp"
+
+namespace hqsort {
+
+namespace detail {
+
+/**
+ * One compare-swap of a sorting network: afterwards the element at lo is
+ * not ordered after the element at hi.
+ */
+struct Comparator {
+    std::uint8_t lo;
+    std::uint8_t hi;
+};
+
+// Sorting networks for 4 to 16 elements. Sizes 4 to 12 and 16 use the
+// fewest comparators known (optimal up to 12); 13 to 15 drop wires from
+// the 16-element network, which costs one comparator over the best known
+// network for 13 only.
+
+inline constexpr std::array<Comparator, 5> network4 = {{
+    {0, 2}, {1, 3}, {0, 1}, {2, 3}, {1, 2}
+}};
+
+inline constexpr std::array<Comparator, 9> network5 = {{
+    {0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1}, {2, 4}, {1, 2}, {3, 4},
+    {2, 3}
+}};
+
+inline constexpr std::array<Comparator, 12> network6 = {{
+    {0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3}, {2, 5}, {0, 1},
+    {2, 3}, {4, 5}, {1, 2}, {3, 4}
+}};
+
+inline constexpr std::array<Comparator, 16> network7 = {{
+    {0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6}, {0, 1}, {2, 5},
+    {3, 4}, {1, 2}, {4, 6}, {2, 3}, {4, 5}, {1, 2}, {3, 4}, {5, 6}
+}};
+
+inline constexpr std::array<Comparator, 19> network8 = {{
+    {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7},
+    {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6},
+    {1, 2}, {3, 4}, {5, 6}
+}};
+
+inline constexpr std::array<Comparator, 25> network9 = {{
+    {0, 3}, {1, 7}, {2, 5}, {4, 8}, {0, 7}, {2, 4}, {3, 8}, {5, 6},
+    {0, 2}, {1, 3}, {4, 5}, {7, 8}, {1, 4}, {3, 6}, {5, 7}, {0, 1},
+    {2, 4}, {3, 5}, {6, 8}, {2, 3}, {4, 5}, {6, 7}, {1, 2}, {3, 4},
+    {5, 6}
+}};
+
+inline constexpr std::array<Comparator, 29> network10 = {{
+    {0, 8}, {1, 9}, {2, 7}, {3, 5}, {4, 6}, {0, 2}, {1, 4}, {5, 8},
+    {7, 9}, {0, 3}, {2, 4}, {5, 7}, {6, 9}, {0, 1}, {3, 6}, {8, 9},
+    {1, 5}, {2, 3}, {4, 8}, {6, 7}, {1, 2}, {3, 5}, {4, 6}, {7, 8},
+    {2, 3}, {4, 5}, {6, 7}, {3, 4}, {5, 6}
+}};
+
+inline constexpr std::array<Comparator, 35> network11 = {{
+    {0, 9}, {1, 6}, {2, 4}, {3, 7}, {5, 8}, {0, 1}, {3, 5}, {4, 10},
+    {6, 9}, {7, 8}, {1, 3}, {2, 5}, {4, 7}, {8, 10}, {0, 4}, {1, 2},
+    {3, 7}, {5, 9}, {6, 8}, {0, 1}, {2, 6}, {4, 5}, {7, 8}, {9, 10},
+    {2, 4}, {3, 6}, {5, 7}, {8, 9}, {1, 2}, {3, 4}, {5, 6}, {7, 8},
+    {2, 3}, {4, 5}, {6, 7}
+}};
+
+inline constexpr std::array<Comparator, 39> network12 = {{
+    {0, 8}, {1, 7}, {2, 6}, {3, 11}, {4, 10}, {5, 9}, {0, 1}, {2, 5},
+    {3, 4}, {6, 9}, {7, 8}, {10, 11}, {0, 2}, {1, 6}, {5, 10}, {9, 11},
+    {0, 3}, {1, 2}, {4, 6}, {5, 7}, {8, 11}, {9, 10}, {1, 4}, {3, 5},
+    {6, 8}, {7, 10}, {1, 3}, {2, 5}, {6, 9}, {8, 10}, {2, 3}, {4, 5},
+    {6, 7}, {8, 9}, {4, 6}, {5, 7}, {3, 4}, {5, 6}, {7, 8}
+}};
+
+inline constexpr std::array<Comparator, 46> network13 = {{
+    {1, 12}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5}, {1, 7}, {2, 9},
+    {3, 4}, {11, 12}, {0, 1}, {2, 3}, {4, 5}, {6, 8}, {7, 9}, {10, 11},
+    {0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7}, {8, 9}, {1, 2}, {3, 12},
+    {4, 6}, {5, 7}, {8, 10}, {9, 11}, {1, 4}, {2, 6}, {5, 8}, {7, 10},
+    {2, 4}, {3, 6}, {9, 12}, {3, 5}, {6, 8}, {7, 9}, {10, 12}, {3, 4},
+    {5, 6}, {7, 8}, {9, 10}, {11, 12}, {6, 7}, {8, 9}
+}};
+
+inline constexpr std::array<Comparator, 51> network14 = {{
+    {0, 13}, {1, 12}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5}, {1, 7},
+    {2, 9}, {3, 4}, {6, 13}, {11, 12}, {0, 1}, {2, 3}, {4, 5}, {6, 8},
+    {7, 9}, {10, 11}, {12, 13}, {0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7},
+    {8, 9}, {1, 2}, {3, 12}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {1, 4},
+    {2, 6}, {5, 8}, {7, 10}, {9, 13}, {2, 4}, {3, 6}, {9, 12}, {11, 13},
+    {3, 5}, {6, 8}, {7, 9}, {10, 12}, {3, 4}, {5, 6}, {7, 8}, {9, 10},
+    {11, 12}, {6, 7}, {8, 9}
+}};
+
+inline constexpr std::array<Comparator, 56> network15 = {{
+    {0, 13}, {1, 12}, {3, 14}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5},
+    {1, 7}, {2, 9}, {3, 4}, {6, 13}, {8, 14}, {11, 12}, {0, 1}, {2, 3},
+    {4, 5}, {6, 8}, {7, 9}, {10, 11}, {12, 13}, {0, 2}, {1, 3}, {4, 10},
+    {5, 11}, {6, 7}, {8, 9}, {12, 14}, {1, 2}, {3, 12}, {4, 6}, {5, 7},
+    {8, 10}, {9, 11}, {13, 14}, {1, 4}, {2, 6}, {5, 8}, {7, 10}, {9, 13},
+    {11, 14}, {2, 4}, {3, 6}, {9, 12}, {11, 13}, {3, 5}, {6, 8}, {7, 9},
+    {10, 12}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {6, 7}, {8, 9}
+}};
+
+inline constexpr std::array<Comparator, 60> network16 = {{
+    {0, 13}, {1, 12}, {2, 15}, {3, 14}, {4, 8}, {5, 6}, {7, 11}, {9, 10},
+    {0, 5}, {1, 7}, {2, 9}, {3, 4}, {6, 13}, {8, 14}, {10, 15}, {11, 12},
+    {0, 1}, {2, 3}, {4, 5}, {6, 8}, {7, 9}, {10, 11}, {12, 13}, {14, 15},
+    {0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7}, {8, 9}, {12, 14}, {13, 15},
+    {1, 2}, {3, 12}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {13, 14}, {1, 4},
+    {2, 6}, {5, 8}, {7, 10}, {9, 13}, {11, 14}, {2, 4}, {3, 6}, {9, 12},
+    {11, 13}, {3, 5}, {6, 8}, {7, 9}, {10, 12}, {3, 4}, {5, 6}, {7, 8},
+    {9, 10}, {11, 12}, {6, 7}, {8, 9}
+}};
+
+/**
+ * Orders two elements. Trivially copyable elements are selected without a
+ * branch so that the compiler can emit conditional moves.
+ *
+ * @param a The element to receive the lesser of the two
+ * @param b The element to receive the greater of the two
+ * @param keys The comparator and projection to order elements by
+ */
+template <class RandomIt, class Keys>
+inline void compareSwap(RandomIt a, RandomIt b, const Keys& keys) {
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    if constexpr (std::is_trivially_copyable_v<Value>) {
+        Value x = *a;
+        Value y = *b;
+        bool swap = keys(y, x);
+        *a = swap ? y : x;
+        *b = swap ? x : y;
+    } else {
+        using std::iter_swap;
+        if (keys(*b, *a)) {
+            iter_swap(a, b);
+        }
+    }
+}
+
+/**
+ * Runs every comparator of a network on the range starting at first,
+ * unrolled at compile time.
+ */
+template <const auto& Network, class RandomIt, class Keys, std::size_t... I>
+inline void applyNetwork(RandomIt first, const Keys& keys, std::index_sequence<I...>) {
+    (compareSwap(first + Network[I].lo, first + Network[I].hi, keys), ...);
+}
+
+template <const auto& Network, class RandomIt, class Keys>
+inline void applyNetwork(RandomIt first, const Keys& keys) {
+    applyNetwork<Network>(first, keys, std::make_index_sequence<Network.size()>());
+}
+
+#if HQSORT_HAS_X86_SIMD
+
+// The zero-masked forms of the AVX-512 min, max and permute intrinsics are
+// used with every lane selected: the unmasked forms pass an undefined
+// vector through, which GCC 12 reports as maybe-uninitialized.
+constexpr __mmask16 kAllLanes = 0xFFFF;
+
+/**
+ * The ten steps of the bitonic network sorting the 16 lanes of a vector.
+ * Each step compares every lane with lane ^ distance and keeps the larger
+ * key in the lanes set in takeMax; the last four steps alone merge a
+ * bitonic vector.
+ */
+struct BitonicTable {
+    std::array<std::array<std::int32_t, 16>, 10> partner{};
+    std::array<std::uint16_t, 10> takeMax{};
+
+    constexpr BitonicTable() {
+        int step = 0;
+        for (int block = 2; block <= 16; block *= 2) {
+            for (int distance = block / 2; distance >= 1; distance /= 2) {
+                for (int lane = 0; lane < 16; ++lane) {
+                    partner[step][lane] = lane ^ distance;
+                    if (((lane & distance) != 0) != ((lane & block) != 0)) {
+                        takeMax[step] |= static_cast<std::uint16_t>(1u << lane);
+                    }
+                }
+                ++step;
+            }
+        }
+    }
+};
+
+inline constexpr BitonicTable bitonicTable{};
+
+__attribute__((target("avx512f"))) inline __m512i bitonicStep(__m512i keys, int step) {
+    __m512i partner = _mm512_maskz_permutexvar_epi32(kAllLanes,
+        _mm512_loadu_si512(bitonicTable.partner[step].data()), keys);
+    return _mm512_mask_mov_epi32(_mm512_maskz_min_epi32(kAllLanes, keys, partner),
+                                 bitonicTable.takeMax[step],
+                                 _mm512_maskz_max_epi32(kAllLanes, keys, partner));
+}
+
+/**
+ * Sorts the 16 lanes of a vector, or only merges them when the vector
+ * already holds a bitonic sequence.
+ */
+__attribute__((target("avx512f"))) inline __m512i bitonicSortVector(__m512i keys, bool merge) {
+    for (int step = merge ? 6 : 0; step < 10; ++step) {
+        keys = bitonicStep(keys, step);
+    }
+    return keys;
+}
+
+/**
+ * Merges the two sorted runs v[0, Width) and v[Width, 2 * Width) of
+ * vectors: reversing the second run makes the pair one bitonic sequence,
+ * which half-cleaners split down to single vectors.
+ */
+template <int Width>
+__attribute__((target("avx512f"))) inline void bitonicMergeVectors(__m512i* v) {
+    const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+                                             10, 11, 12, 13, 14, 15);
+    for (int i = 0; i < Width; ++i) {
+        __m512i low = v[i];
+        __m512i high = _mm512_maskz_permutexvar_epi32(kAllLanes, reverse, v[2 * Width - 1 - i]);
+        v[i] = _mm512_maskz_min_epi32(kAllLanes, low, high);
+        v[2 * Width - 1 - i] = _mm512_maskz_max_epi32(kAllLanes, low, high);
+    }
+    // The maxima were written in mirrored vector order; restore it. Both
+    // halves are now bitonic, and no key of the lower exceeds the upper
+    for (int i = 0; i < Width / 2; ++i) {
+        std::swap(v[Width + i], v[2 * Width - 1 - i]);
+    }
+    for (int distance = Width / 2; distance >= 1; distance /= 2) {
+        for (int i = 0; i < 2 * Width; ++i) {
+            if ((i & distance) == 0) {
+                __m512i low = _mm512_maskz_min_epi32(kAllLanes, v[i], v[i + distance]);
+                v[i + distance] = _mm512_maskz_max_epi32(kAllLanes, v[i], v[i + distance]);
+                v[i] = low;
+            }
+        }
+    }
+    for (int i = 0; i < 2 * Width; ++i) {
+        v[i] = bitonicSortVector(v[i], true);
+    }
+}
+
+/**
+ * Sorts up to 16 * Vectors ints held in AVX-512 registers. Missing lanes
+ * are padded with INT_MAX, which sorts to the end and is never stored.
+ */
+template <int Vectors>
+__attribute__((target("avx512f"))) inline void bitonicSortInts(int* data, std::ptrdiff_t n) {
+    const __m512i padding = _mm512_set1_epi32(INT_MAX);
+    __m512i v[Vectors];
+    __mmask16 masks[Vectors];
+    for (int i = 0; i < Vectors; ++i) {
+        std::ptrdiff_t lanes = n - 16 * i;
+        masks[i] = lanes >= 16 ? static_cast<__mmask16>(0xFFFF)
+                 : lanes <= 0  ? static_cast<__mmask16>(0)
+                               : static_cast<__mmask16>((1u << lanes) - 1);
+        v[i] = bitonicSortVector(_mm512_mask_loadu_epi32(padding, masks[i], data + 16 * i), false);
+    }
+    if constexpr (Vectors >= 2) {
+        for (int i = 0; i < Vectors; i += 2) {
+            bitonicMergeVectors<1>(v + i);
+        }
+    }
+    if constexpr (Vectors >= 4) {
+        bitonicMergeVectors<2>(v);
+    }
+    for (int i = 0; i < Vectors; ++i) {
+        _mm512_mask_storeu_epi32(data + 16 * i, masks[i], v[i]);
+    }
+}
+
+#endif // HQSORT_HAS_X86_SIMD
+
+} // namespace detail
+
+/**
+ * Sorts a small range with branchless sorting networks.
+ *
+ * Ranges of 4 to 16 elements run a fixed network of compare-swaps, with no
+ * data-dependent branches for trivially copyable elements. Ranges of 17 to
+ * 64 ints ordered ascending are sorted by a bitonic network in AVX-512
+ * registers when the CPU supports it. Longer ranges, and ranges over 16
+ * elements of other types, fall back to insertionSort.
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param keys The comparator and projection to order elements by
+ */
+template <class RandomIt, class Keys>
+void networkSort(RandomIt first, RandomIt last, const Keys& keys) {
+    auto N = last - first;
+    if (N <= 3) {
+        manualSort(first, last, keys);
+        return;
+    }
+
+#if HQSORT_HAS_X86_SIMD
+    if constexpr (detail::isSimdIntRange<RandomIt, Keys>) {
+        if (N > 16 && N <= 64 && simdLevel() == SimdLevel::Avx512) {
+            int* data = &*first;
+            if (N <= 32) {
+                detail::bitonicSortInts<2>(data, N);
+            } else {
+                detail::bitonicSortInts<4>(data, N);
+            }
+            return;
+        }
+    }
+#endif
+
+    switch (N) {
+    case 4:
+        detail::applyNetwork<detail::network4>(first, keys);
+        break;
+    case 5:
+        detail::applyNetwork<detail::network5>(first, keys);
+        break;
+    case 6:
+        detail::applyNetwork<detail::network6>(first, keys);
+        break;
+    case 7:
+        detail::applyNetwork<detail::network7>(first, keys);
+        break;
+    case 8:
+        detail::applyNetwork<detail::network8>(first, keys);
+        break;
+    case 9:
+        detail::applyNetwork<detail::network9>(first, keys);
+        break;
+    case 10:
+        detail::applyNetwork<detail::network10>(first, keys);
+        break;
+    case 11:
+        detail::applyNetwork<detail::network11>(first, keys);
+        break;
+    case 12:
+        detail::applyNetwork<detail::network12>(first, keys);
+        break;
+    case 13:
+        detail::applyNetwork<detail::network13>(first, keys);
+        break;
+    case 14:
+        detail::applyNetwork<detail::network14>(first, keys);
+        break;
+    case 15:
+        detail::applyNetwork<detail::network15>(first, keys);
+        break;
+    case 16:
+        detail::applyNetwork<detail::network16>(first, keys);
+        break;
+    default:
+        insertionSort(first, last, keys);
+        break;
+    }
+}
+
+/**
+ * Leaf policy running networkSort.
+ */
+struct SortingNetworkLeaf {
+    template <class RandomIt, class Keys>
+    static void sort(RandomIt first, RandomIt last, const Keys& keys) {
+        networkSort(first, last, keys);
+    }
+};
+
+/**
+ * The proposed algorithm with sorting-network leaves up to a given size.
+ */
+template <std::ptrdiff_t Threshold = 16, class PivotRule = MinMaxProbePivot,
+          class PartitionScheme = HoarePartition>
+using NetworkPolicy = ProposedPolicy<Threshold, PivotRule, PartitionScheme, SortingNetworkLeaf>;
+
+} // namespace hqsort
+
+#endif // HQSORT_SORTING_NETWORK_HPP
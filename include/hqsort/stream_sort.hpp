@@ -0,0 +1,237 @@
+#ifndef HQSORT_STREAM_SORT_HPP
+#define HQSORT_STREAM_SORT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "external_sort.hpp"
+#include "int_reader.hpp"
+#include "keys.hpp"
+#include "policy.hpp"
+#include "quicksort.hpp"
+
+namespace hqsort {
+
+/**
+ * Settings of streamSort.
+ *
+ * The input is cut into chunks of chunkElements ints, which sortThreads
+ * threads sort while the next chunks are parsed. The merge hands the
+ * formatter blocks of blockElements ints.
+ */
+struct StreamSortOptions {
+    std::size_t chunkElements = std::size_t(1) << 20;
+    unsigned sortThreads = std::thread::hardware_concurrency() > 2 ? std::thread::hardware_concurrency() - 1 : 1;
+    std::size_t blockElements = std::size_t(1) << 16;
+};
+
+/**
+ * What a streamSort call did, for throughput reports.
+ */
+struct StreamSortStats {
+    std::size_t elements = 0;
+    std::size_t chunks = 0;
+    std::size_t malformedLines = 0;
+    std::vector<ParseError> errors; // The first IntegerReader::kReportedErrors
+    std::uintmax_t inputBytes = 0;
+    std::uintmax_t outputBytes = 0;
+    double parseSeconds = 0; // Until the last chunk was parsed
+    double seconds = 0;
+};
+
+namespace detail {
+
+/**
+ * An unbounded queue between two pipeline stages. pop() waits for an item
+ * and returns false once the queue is closed and drained.
+ */
+template <class T>
+class Channel {
+public:
+    void push(T item) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(std::move(item));
+        }
+        ready_.notify_one();
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        ready_.notify_all();
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return !items_.empty() || closed_; });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+/**
+ * A sorted chunk in memory as a LoserTree source.
+ */
+struct ChunkCursor {
+    const int* next;
+    const int* last;
+
+    bool empty() const {
+        return next == last;
+    }
+    int front() const {
+        return *next;
+    }
+    void pop() {
+        ++next;
+    }
+};
+
+} // namespace detail
+
+/**
+ * Sorts newline-separated ints from one stream into another, overlapping
+ * the stages of the work on separate threads:
+ *
+ * 1. The calling thread parses the input with IntegerReader into chunks of
+ *    options.chunkElements ints and queues each full chunk.
+ * 2. options.sortThreads threads sort the queued chunks with quickSort
+ *    while parsing continues.
+ * 3. Once the input ends, the calling thread merges the sorted chunks with
+ *    a loser tree into blocks of options.blockElements ints.
+ * 4. A formatter thread turns the blocks into decimal lines in a 1 MB
+ *    buffer and writes it with one fwrite at a time; nothing is flushed
+ *    per element.
+ *
+ * The whole input is held in memory; use externalSort for inputs that do
+ * not fit. Malformed lines are skipped and reported in stats.
+ *
+ * @param input The stream to read, such as stdin
+ * @param output The stream to write the sorted ints to, one per line
+ * @param options The chunk size, sort threads and merge block size
+ * @param stats Receives counts and timings of the sort
+ * @param comp The strict weak ordering of the ints
+ *
+ * @return false if the input could not be read or the output written
+ */
+template <class Policy = DefaultPolicy, class Compare = std::less<>>
+bool streamSort(std::FILE* input, std::FILE* output, const StreamSortOptions& options,
+                StreamSortStats& stats, Compare comp = {}) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    stats = StreamSortStats();
+    KeyCompare<Compare, identity> keys{comp, {}};
+
+    // Sort chunks as the parser queues them
+    detail::Channel<std::pair<int*, std::size_t>> unsorted;
+    std::vector<std::thread> sorters;
+    for (unsigned i = 0; i < std::max(options.sortThreads, 1u); ++i) {
+        sorters.emplace_back([&unsorted, &keys] {
+            std::pair<int*, std::size_t> chunk;
+            while (unsorted.pop(chunk)) {
+                quickSort<Policy>(chunk.first, chunk.first + chunk.second, keys);
+            }
+        });
+    }
+
+    IntegerReader reader(input);
+    std::size_t chunkElements = std::max<std::size_t>(options.chunkElements, 1);
+    std::vector<std::unique_ptr<int[]>> chunks;
+    std::vector<detail::ChunkCursor> cursors;
+    while (!reader.eof() && !reader.failed()) {
+        chunks.emplace_back(new int[chunkElements]);
+        std::size_t size = reader.read(chunks.back().get(), chunkElements);
+        if (size == 0) {
+            chunks.pop_back();
+            continue;
+        }
+        cursors.push_back({chunks.back().get(), chunks.back().get() + size});
+        unsorted.push({chunks.back().get(), size});
+        stats.elements += size;
+    }
+    unsorted.close();
+    stats.parseSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (std::thread& sorter : sorters) {
+        sorter.join();
+    }
+    stats.chunks = chunks.size();
+    stats.inputBytes = reader.bytesRead();
+    stats.malformedLines = reader.malformedLines();
+    stats.errors = reader.errors();
+
+    // Format and write merged blocks while the next ones are merged; the
+    // blocks circulate between the two threads, so at most four exist
+    detail::Channel<std::vector<int>> full;
+    detail::Channel<std::vector<int>> empty;
+    std::size_t blockElements = std::max<std::size_t>(options.blockElements, 1);
+    for (int i = 0; i < 4; ++i) {
+        std::vector<int> block;
+        block.reserve(blockElements);
+        empty.push(std::move(block));
+    }
+    bool written = false;
+    std::thread formatter([&] {
+        detail::RunWriter writer(output, std::size_t(1) << 20, true);
+        std::vector<int> block;
+        while (full.pop(block)) {
+            for (int value : block) {
+                writer.push(value);
+            }
+            block.clear();
+            empty.push(std::move(block));
+        }
+        written = writer.flush() && std::fflush(output) == 0;
+        stats.outputBytes = writer.written();
+    });
+
+    if (!cursors.empty()) {
+        detail::LoserTree<decltype(keys), detail::ChunkCursor> tree(cursors, keys);
+        std::vector<int> block;
+        empty.pop(block);
+        for (detail::ChunkCursor* source = &tree.winner(); !source->empty(); source = &tree.winner()) {
+            block.push_back(source->front());
+            source->pop();
+            tree.replay();
+            if (block.size() == blockElements) {
+                full.push(std::move(block));
+                empty.pop(block);
+            }
+        }
+        if (!block.empty()) {
+            full.push(std::move(block));
+        }
+    }
+    full.close();
+    formatter.join();
+
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return !reader.failed() && written;
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_STREAM_SORT_HPP
@@ -0,0 +1,289 @@
+#ifndef HQSORT_THREAD_POOL_HPP
+#define HQSORT_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hqsort {
+
+/**
+ * Work-stealing thread pool.
+ *
+ * Every worker owns a task deque: it pushes and pops its own tasks at the
+ * back (newest, smallest, still cache-hot) and steals from the front of the
+ * other deques (oldest, largest) when its own runs dry. Threads outside the
+ * pool share one extra deque, so a caller that waits on its tasks can help
+ * run them through runPendingTask() instead of blocking.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * Starts a pool for the given total number of threads. The thread that
+     * waits on the pool counts as one of them, so threads - 1 workers are
+     * started.
+     *
+     * @param threads The number of threads that run tasks, at least 1
+     */
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+        unsigned workers = threads > 1 ? threads - 1 : 0;
+        for (unsigned i = 0; i <= workers; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < workers; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Finishes the queued tasks and joins the workers.
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Returns the number of threads that run tasks, counting the caller.
+     */
+    unsigned threads() const {
+        return static_cast<unsigned>(workers_.size()) + 1;
+    }
+
+    /**
+     * Queues a task on the current thread's deque. If queueing throws, the
+     * task is not queued and the exception propagates.
+     *
+     * @param task The task to run
+     */
+    void submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            ++queued_;
+        }
+        Queue& queue = *queues_[currentQueue()];
+        try {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            --queued_;
+            throw;
+        }
+        wake_.notify_one();
+    }
+
+    /**
+     * Runs one queued task, preferring the current thread's own deque and
+     * otherwise stealing from another.
+     *
+     * @return True if a task was run
+     */
+    bool runPendingTask() {
+        std::size_t own = currentQueue();
+        Task task;
+
+        // Pop the newest task from our own deque
+        if (!popBack(own, task)) {
+            // Steal the oldest task from the other deques in turn
+            bool stolen = false;
+            for (std::size_t k = 1; k < queues_.size() && !stolen; ++k) {
+                stolen = popFront((own + k) % queues_.size(), task);
+            }
+            if (!stolen) {
+                return false;
+            }
+        }
+
+        --queued_;
+        task();
+        return true;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * Returns the deque of the calling thread: its own for a worker of this
+     * pool, the shared external deque for any other thread.
+     */
+    std::size_t currentQueue() const {
+        return currentPool_ == this ? currentIndex_ : queues_.size() - 1;
+    }
+
+    bool popBack(std::size_t index, Task& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool popFront(std::size_t index, Task& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    /**
+     * Runs tasks until the pool is destroyed, sleeping while none are queued.
+     *
+     * @param index The worker's own deque
+     */
+    void workerLoop(std::size_t index) {
+        currentPool_ = this;
+        currentIndex_ = index;
+        while (true) {
+            if (runPendingTask()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> queued_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+
+    inline static thread_local const ThreadPool* currentPool_ = nullptr;
+    inline static thread_local std::size_t currentIndex_ = 0;
+};
+
+/**
+ * A set of tasks run on a ThreadPool that can be waited on together.
+ *
+ * Tasks may add more tasks to the same group. wait() helps run queued tasks
+ * until the whole group is done, so a task can wait on a nested group
+ * without tying up its thread, and rethrows the first exception any task
+ * threw.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * Waits for the remaining tasks; their exceptions are dropped.
+     */
+    ~TaskGroup() {
+        drain();
+    }
+
+    /**
+     * Returns the pool the group runs on.
+     */
+    ThreadPool& pool() const {
+        return pool_;
+    }
+
+    /**
+     * Queues a task in the group. If queueing throws, the task is not
+     * counted and the exception propagates.
+     *
+     * @param task The task to run
+     */
+    template <class Function>
+    void run(Function&& task) {
+        // Count the task before it can run, so it never finishes uncounted
+        ++pending_;
+        try {
+            pool_.submit([this, task = std::forward<Function>(task)]() mutable {
+                try {
+                    task();
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                --pending_;
+            });
+        } catch (...) {
+            --pending_;
+            throw;
+        }
+    }
+
+    /**
+     * Records an exception to be rethrown by wait(); only the first one is
+     * kept.
+     *
+     * @param exception The exception to record
+     */
+    void fail(std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+            error_ = exception;
+        }
+    }
+
+    /**
+     * Runs queued tasks until every task of the group has finished, then
+     * rethrows the first recorded exception.
+     */
+    void wait() {
+        drain();
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(error, error_);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    void drain() {
+        while (pending_ > 0) {
+            if (!pool_.runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    ThreadPool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex mutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_THREAD_POOL_HPP
@@ -0,0 +1,70 @@
+#ifndef HQSORT_THREE_WAY_PARTITION_HPP
+#define HQSORT_THREE_WAY_PARTITION_HPP
+
+#include <iterator>
+#include <utility>
+
+#include "keys.hpp"
+
+namespace hqsort {
+
+/**
+ * Three-way (Dutch national flag) partition of a range around a pivot key:
+ * keys below the pivot come first, keys equal to it next, and keys above
+ * it last. The equal keys are in their final place, so the sort recurses
+ * only into the outer parts; on inputs with few distinct keys most of the
+ * range is settled by one pass.
+ *
+ * The pivot must lie between the smallest and largest key of the range,
+ * which leaves at least one element outside each outer part.
+ *
+ * @param first The start of the range to partition
+ * @param last The end of the range to partition
+ * @param pivot The pivot key to partition around
+ * @param keys The comparator and projection to order elements by
+ *
+ * @return The range of the keys equal to the pivot
+ */
+template <class RandomIt, class Key, class Keys>
+std::pair<RandomIt, RandomIt> threeWayPartition(RandomIt first, RandomIt last,
+                                                const Key& pivot,
+                                                const Keys& keys) {
+    using std::iter_swap;
+
+    // [first, less) is below the pivot, [less, i) equal to it, [greater, last)
+    // above it, and [i, greater) not yet seen
+    RandomIt less = first;
+    RandomIt i = first;
+    RandomIt greater = last;
+    while (i != greater) {
+        if (keys.less(keys.key(*i), pivot)) {
+            iter_swap(less, i);
+            ++less;
+            ++i;
+        } else if (keys.less(pivot, keys.key(*i))) {
+            --greater;
+            iter_swap(i, greater);
+        } else {
+            ++i;
+        }
+    }
+    return {less, greater};
+}
+
+/**
+ * Partition policy running threeWayPartition. quickSort skips the keys
+ * equal to the pivot when a scheme returns a range instead of a split
+ * point.
+ */
+struct ThreeWayPartition {
+    template <class RandomIt, class Key, class Keys>
+    static std::pair<RandomIt, RandomIt> partition(RandomIt first, RandomIt last,
+                                                   const Key& pivot,
+                                                   const Keys& keys) {
+        return threeWayPartition(first, last, pivot, keys);
+    }
+};
+
+} // namespace hqsort
+
+#endif // HQSORT_THREE_WAY_PARTITION_HPP
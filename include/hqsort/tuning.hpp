@@ -0,0 +1,347 @@
+#ifndef HQSORT_TUNING_HPP
+#define HQSORT_TUNING_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "block_partition.hpp"
+#include "dual_pivot_partition.hpp"
+#include "keys.hpp"
+#include "leaf.hpp"
+#include "partition.hpp"
+#include "policy.hpp"
+#include "quicksort.hpp"
+#include "simd_partition.hpp"
+#include "sorting_network.hpp"
+#include "three_way_partition.hpp"
+
+namespace hqsort {
+
+/**
+ * Partition schemes a tuning profile can select.
+ */
+enum class PartitionKind {
+    Hoare,
+    Block,
+    Simd,
+    ThreeWay,
+    DualPivot
+};
+
+/**
+ * Leaf routines a tuning profile can select.
+ */
+enum class LeafKind {
+    Insertion,
+    Network
+};
+
+/**
+ * The settings of tunedSort, written by the tuner (Benchmark/tuner.cpp).
+ *
+ * Profiles are text files of key=value lines; lines starting with '#' are
+ * comments:
+ *
+ *     cutoff=32
+ *     partition=hoare
+ *     leaf=network
+ */
+struct TuningProfile {
+    std::ptrdiff_t cutoff = DefaultPolicy::insertionSortCutoff;
+    PartitionKind partition = PartitionKind::Hoare;
+    LeafKind leaf = LeafKind::Insertion;
+};
+
+/**
+ * The largest cutoff a profile file may set. The tuner sweeps up to 128;
+ * far larger cutoffs only turn tunedSort into a quadratic insertion sort,
+ * so they are taken for typos.
+ */
+constexpr std::ptrdiff_t maxTuningCutoff = 1024;
+
+/**
+ * Returns the profile name of a partition scheme.
+ */
+inline const char* toString(PartitionKind kind) {
+    switch (kind) {
+    case PartitionKind::Block:
+        return "block";
+    case PartitionKind::Simd:
+        return "simd";
+    case PartitionKind::ThreeWay:
+        return "threeway";
+    case PartitionKind::DualPivot:
+        return "dualpivot";
+    case PartitionKind::Hoare:
+        break;
+    }
+    return "hoare";
+}
+
+/**
+ * Returns the profile name of a leaf routine.
+ */
+inline const char* toString(LeafKind kind) {
+    return kind == LeafKind::Network ? "network" : "insertion";
+}
+
+/**
+ * Parses a partition scheme name.
+ *
+ * @return true if the name was recognised
+ */
+inline bool parsePartitionKind(const std::string& name, PartitionKind& kind) {
+    for (PartitionKind candidate : {PartitionKind::Hoare, PartitionKind::Block, PartitionKind::Simd,
+                                   PartitionKind::ThreeWay, PartitionKind::DualPivot}) {
+        if (name == toString(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Parses a leaf routine name.
+ *
+ * @return true if the name was recognised
+ */
+inline bool parseLeafKind(const std::string& name, LeafKind& kind) {
+    for (LeafKind candidate : {LeafKind::Insertion, LeafKind::Network}) {
+        if (name == toString(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Reads a tuning profile. Settings missing from the file keep their value
+ * in profile.
+ *
+ * @param path The profile file to read
+ * @param profile The profile to update
+ *
+ * @return false if the file could not be opened, has a malformed line or
+ *         a cutoff outside [0, maxTuningCutoff], in which case profile is
+ *         left unchanged
+ */
+inline bool loadTuningProfile(const std::string& path, TuningProfile& profile) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TuningProfile loaded = profile;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::string::size_type equals = line.find('=');
+        if (equals == std::string::npos) {
+            return false;
+        }
+        std::string key = line.substr(0, equals);
+        std::string value = line.substr(equals + 1);
+
+        if (key == "cutoff") {
+            char* end = nullptr;
+            long long cutoff = std::strtoll(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || cutoff < 0 || cutoff > maxTuningCutoff) {
+                return false;
+            }
+            loaded.cutoff = static_cast<std::ptrdiff_t>(cutoff);
+        } else if (key == "partition") {
+            if (!parsePartitionKind(value, loaded.partition)) {
+                return false;
+            }
+        } else if (key == "leaf") {
+            if (!parseLeafKind(value, loaded.leaf)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    profile = loaded;
+    return true;
+}
+
+/**
+ * Writes a tuning profile.
+ *
+ * @param path The profile file to write
+ * @param profile The profile to write
+ * @param comment Text written as a comment above the settings, one '#'
+ *                line per line of text
+ *
+ * @return false if the file could not be written
+ */
+inline bool saveTuningProfile(const std::string& path, const TuningProfile& profile,
+                              const std::string& comment = "") {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string::size_type start = 0;
+    while (start < comment.size()) {
+        std::string::size_type end = comment.find('\n', start);
+        if (end == std::string::npos) {
+            end = comment.size();
+        }
+        file << "# " << comment.substr(start, end - start) << '\n';
+        start = end + 1;
+    }
+    file << "cutoff=" << profile.cutoff << '\n';
+    file << "partition=" << toString(profile.partition) << '\n';
+    file << "leaf=" << toString(profile.leaf) << '\n';
+    return static_cast<bool>(file);
+}
+
+namespace detail {
+
+inline std::mutex& tuningProfileMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * The profile in use; read and written only under tuningProfileMutex().
+ */
+inline TuningProfile& currentTuningProfile() {
+    static TuningProfile profile = [] {
+        TuningProfile loaded;
+        const char* path = std::getenv("HQSORT_PROFILE");
+        if (path != nullptr) {
+            loadTuningProfile(path, loaded);
+        }
+        return loaded;
+    }();
+    return profile;
+}
+
+} // namespace detail
+
+/**
+ * The profile tunedSort runs with. It is loaded once, on first use, from
+ * the file named by the HQSORT_PROFILE environment variable; no other file
+ * is read, so a program behaves the same wherever it is started. Without
+ * the variable or a readable profile the defaults apply, which match
+ * DefaultPolicy, until useTuningProfile() replaces them.
+ *
+ * @return A copy of the profile, so it cannot change while it is used
+ */
+inline TuningProfile tuningProfile() {
+    std::lock_guard<std::mutex> lock(detail::tuningProfileMutex());
+    return detail::currentTuningProfile();
+}
+
+/**
+ * Replaces the profile tunedSort runs with. It may be called while other
+ * threads sort: each tunedSort call copies the profile when it starts, so
+ * it runs wholly with either the old or the new profile.
+ *
+ * @param profile The settings to sort with
+ */
+inline void useTuningProfile(const TuningProfile& profile) {
+    std::lock_guard<std::mutex> lock(detail::tuningProfileMutex());
+    detail::currentTuningProfile() = profile;
+}
+
+/**
+ * Loads the profile tunedSort runs with from a file, such as one written
+ * by the tuner.
+ *
+ * @param path The profile file to read
+ *
+ * @return false if the file could not be read, in which case the current
+ *         profile stays in use
+ */
+inline bool useTuningProfile(const std::string& path) {
+    TuningProfile loaded;
+    if (!loadTuningProfile(path, loaded)) {
+        return false;
+    }
+    useTuningProfile(loaded);
+    return true;
+}
+
+/**
+ * Policy with a leaf cutoff chosen at run time. The cutoff is per thread:
+ * tunedSort sets it from its copy of the profile for the length of the
+ * call, so a sort never sees another thread's profile or a cutoff that
+ * changes under it.
+ */
+template <class PartitionScheme, class LeafRoutine>
+struct TunedPolicy : DefaultPolicy {
+    static inline thread_local std::ptrdiff_t insertionSortCutoff = DefaultPolicy::insertionSortCutoff;
+    using Partition = PartitionScheme;
+    using Leaf = LeafRoutine;
+};
+
+namespace detail {
+
+template <class Policy, class RandomIt, class Keys>
+void quickSortWithCutoff(RandomIt first, RandomIt last, const Keys& keys, std::ptrdiff_t cutoff) {
+    // Restore the cutoff afterwards, for a tunedSort called from a comparator
+    std::ptrdiff_t outerCutoff = Policy::insertionSortCutoff;
+    Policy::insertionSortCutoff = cutoff;
+    quickSort<Policy>(first, last, keys);
+    Policy::insertionSortCutoff = outerCutoff;
+}
+
+template <class PartitionScheme, class RandomIt, class Keys>
+void tunedQuickSort(RandomIt first, RandomIt last, const Keys& keys, const TuningProfile& profile) {
+    if (profile.leaf == LeafKind::Network) {
+        quickSortWithCutoff<TunedPolicy<PartitionScheme, SortingNetworkLeaf>>(first, last, keys, profile.cutoff);
+    } else {
+        quickSortWithCutoff<TunedPolicy<PartitionScheme, InsertionSortLeaf>>(first, last, keys, profile.cutoff);
+    }
+}
+
+} // namespace detail
+
+/**
+ * Sorts [first, last) with the cutoff, partition scheme and leaf routine
+ * of the loaded tuning profile (see tuningProfile()).
+ *
+ * @param first The start of the range to sort
+ * @param last The end of the range to sort
+ * @param comp The strict weak ordering of keys
+ * @param proj The projection from an element to its key
+ */
+template <class RandomIt, class Compare = std::less<>, class Projection = identity>
+void tunedSort(RandomIt first, RandomIt last, Compare comp = {}, Projection proj = {}) {
+    KeyCompare<Compare, Projection> keys{comp, proj};
+    const TuningProfile profile = tuningProfile();
+    switch (profile.partition) {
+    case PartitionKind::Block:
+        detail::tunedQuickSort<BlockPartition>(first, last, keys, profile);
+        break;
+    case PartitionKind::Simd:
+        detail::tunedQuickSort<SimdPartition>(first, last, keys, profile);
+        break;
+    case PartitionKind::ThreeWay:
+        detail::tunedQuickSort<ThreeWayPartition>(first, last, keys, profile);
+        break;
+    case PartitionKind::DualPivot:
+        detail::tunedQuickSort<DualPivotPartition>(first, last, keys, profile);
+        break;
+    case PartitionKind::Hoare:
+        detail::tunedQuickSort<HoarePartition>(first, last, keys, profile);
+        break;
+    }
+}
+
+} // namespace hqsort
+
+#endif // HQSORT_TUNING_HPP